@@ -2,13 +2,20 @@
 
 /* PUBLIC FUNCTIONS */
 
+HomeyDevice::HomeyDevice(HomeyClass* homey, const String& name, const String& deviceClass)
+: _master_host(0,0,0,0)
+{
+	_homey = homey;
+	_deviceName = name;
+	_deviceClass = deviceClass;
+	_master_port = 9999;
+}
+
 HomeyClass::HomeyClass( uint16_t port )
-: _tcpServer(port), _udpServer(), _master_host(0,0,0,0)
+: HomeyDevice(this, ""), _tcpServer(port), _udpServer()
 {
 	_port = port;
-	_deviceName = "";
-	_deviceClass = DCLASS_OTHER;
-	_master_port = 9999;
+	_requestDevice = this;
 }
 
 void HomeyClass::begin(const String& name, const String& type)
@@ -16,7 +23,11 @@ void HomeyClass::begin(const String& name, const String& type)
 	_deviceName = name;
 	_deviceType = type;
 	_tcpServer.begin();
+#if defined(HOMEY_USE_POSIX)
+	_udpServer.begin(_localAddress, _port);
+#else
 	_udpServer.begin(_port);
+#endif
 }
 
 void HomeyClass::stop()
@@ -27,115 +38,194 @@ void HomeyClass::stop()
 	_udpServer.stop();
 }
 
-String HomeyClass::getName()
+HomeyDevice* HomeyClass::addDevice(const String& id, const String& deviceClass)
+{
+	//The id doubles as the request prefix, so it has to be a single path segment
+	if ((id.length()<1) || (id.length()>=MAX_NAME_LENGTH)) return NULL;
+	for (uint16_t i = 0; i<id.length(); i++) {
+		char c = id.charAt(i);
+		if ((c=='/') || (c=='?') || (c==' ')) return NULL;
+	}
+	//...that must not be mistaken for an endpoint type of the primary device
+	if ((id==TYPE_ACTION) || (id==TYPE_CONDITION) || (id==TYPE_CAPABILITY) || (id==TYPE_SYSTEM) || (id==TYPE_REMOTE)) return NULL;
+	if (findDevice(id.c_str())!=NULL) return NULL;
+
+	HomeyDevice* newDevice = new HomeyDevice(this, id, deviceClass);
+	if (newDevice==NULL) { DEBUG_PRINTLN("Alloc error for device"); return NULL; }
+
+	if (firstDevice==NULL) {
+		firstDevice = newDevice;
+	} else {
+		HomeyDevice* last = firstDevice;
+		while (last->nextDevice!=NULL) last = last->nextDevice; //Follow links until end of list
+		last->nextDevice = newDevice;
+	}
+	return newDevice;
+}
+
+HomeyDevice* HomeyClass::findDevice(const char* id)
+{
+	HomeyDevice* device = firstDevice;
+	while (device!=NULL) {
+		if (device->_deviceName==id) return device;
+		device = device->nextDevice;
+	}
+	return NULL;
+}
+
+bool HomeyClass::removeDevice(const char* id)
+{
+	HomeyDevice* prev = NULL;
+	HomeyDevice* device = firstDevice;
+	while (device!=NULL) {
+		if (device->_deviceName==id) {
+			if (prev==NULL) {
+				firstDevice = device->nextDevice;
+			} else {
+				prev->nextDevice = device->nextDevice;
+			}
+			if (_requestDevice==device) _requestDevice = this;
+			_emitStats.forget(device);
+			device->clear();
+			delete device;
+			return true;
+		}
+		prev = device;
+		device = device->nextDevice;
+	}
+	return false;
+}
+
+String HomeyDevice::getName()
 {
 	return _deviceName;
 }
 
-void HomeyClass::setName(const String& deviceName)
+void HomeyDevice::setName(const String& deviceName)
 {
 	_deviceName = deviceName;
 }
 
-String HomeyClass::getClass()
+String HomeyDevice::getClass()
 {
 	return _deviceClass;
 }
 
-void HomeyClass::setClass(const String& deviceClass)
+void HomeyDevice::setClass(const String& deviceClass)
 {
 	_deviceClass = deviceClass;
 }
 
-bool HomeyClass::addAction(const String& name, CallbackFunction fn)
+void HomeyDevice::setMaster(const IPAddress& host, uint16_t port)
+{
+	_master_host = host;
+	_master_port = port;
+}
+
+bool HomeyDevice::addAction(const String& name, CallbackFunction fn)
 {
 	return on(name.c_str(), TYPE_ACTION, fn);
 }
 
-bool HomeyClass::addCondition(const String& name, CallbackFunction fn)
+bool HomeyDevice::addCondition(const String& name, CallbackFunction fn)
 {	//Register a condition
 	return on(name.c_str(), TYPE_CONDITION, fn);
 }
 
-bool HomeyClass::addCapability(const String& name, CallbackFunction fn)
+bool HomeyDevice::addCapability(const String& name, CallbackFunction fn)
 {	//Register a capability
 	return on(name.c_str(), TYPE_CAPABILITY, fn, true);
 }
 
+bool HomeyDevice::addAction(const String& name, const HomeyDelegate& fn)
+{
+	return on(name.c_str(), TYPE_ACTION, NULL, false, fn);
+}
+
+bool HomeyDevice::addCondition(const String& name, const HomeyDelegate& fn)
+{
+	return on(name.c_str(), TYPE_CONDITION, NULL, false, fn);
+}
+
+bool HomeyDevice::addCapability(const String& name, const HomeyDelegate& fn)
+{
+	return on(name.c_str(), TYPE_CAPABILITY, NULL, true, fn);
+}
+
 bool HomeyClass::addRc(const String& name, CallbackFunction fn)
 {	//Register a remote configuration endpoint
 	return on(name.c_str(), TYPE_REMOTE, fn);
 }
 
-HomeyFunction* HomeyClass::findAction(const char* name)
+HomeyFunction* HomeyDevice::findAction(const char* name)
 {
 	return find(name, TYPE_ACTION);
 }
 
-HomeyFunction* HomeyClass::findCondition(const char* name)
+HomeyFunction* HomeyDevice::findCondition(const char* name)
 {
 	return find(name, TYPE_CONDITION);
 }
 
-HomeyFunction* HomeyClass::findCapability(const char* name)
+HomeyFunction* HomeyDevice::findCapability(const char* name)
 {
 	return find(name, TYPE_CAPABILITY);
 }
 
-bool HomeyClass::removeAction(const char* name)
+bool HomeyDevice::removeAction(const char* name)
 {
 	return remove(name, TYPE_ACTION);
 }
 
-bool HomeyClass::removeCondition(const char* name)
+bool HomeyDevice::removeCondition(const char* name)
 {
 	return remove(name, TYPE_CONDITION);
 }
 
-bool HomeyClass::removeCapability(const char* name)
+bool HomeyDevice::removeCapability(const char* name)
 {
 	return remove(name, TYPE_CAPABILITY);
 }
 
-void HomeyClass::clear()
+void HomeyDevice::clear()
 {
 	while (remove("","")); //This deletes all endpoints
 }
 
-bool HomeyClass::trigger(const String& name)
+bool HomeyDevice::trigger(const String& name)
 {
 	return _emit(name.c_str(), CTYPE_NULL, "\"\"", TYPE_TRIGGER);
 }
-bool HomeyClass::trigger(const String& name, const char* value)
+bool HomeyDevice::trigger(const String& name, const char* value)
 {
 	return _emit(name.c_str(), CTYPE_STRING, "\""+String(value)+"\"", TYPE_TRIGGER);
 }
-bool HomeyClass::trigger(const String& name, const String& value)
+bool HomeyDevice::trigger(const String& name, const String& value)
 {
 	return _emit(name.c_str(), CTYPE_STRING, "\""+value+"\"", TYPE_TRIGGER);
 }
-bool HomeyClass::trigger(const String& name, int value)
+bool HomeyDevice::trigger(const String& name, int value)
 {
 	return _emit(name.c_str(), CTYPE_INT, String(value), TYPE_TRIGGER);
 }
-bool HomeyClass::trigger(const String& name, float value)
+bool HomeyDevice::trigger(const String& name, float value)
 {
 	return _emit(name.c_str(), CTYPE_FLOAT, String(value), TYPE_TRIGGER);
 }
 
-bool HomeyClass::trigger(const String& name, double value)
+bool HomeyDevice::trigger(const String& name, double value)
 {
 	return _emit(name.c_str(), CTYPE_DOUBLE, String(value), TYPE_TRIGGER);
 }
 
-bool HomeyClass::trigger(const String& name, bool value)
+bool HomeyDevice::trigger(const String& name, bool value)
 {
 	String str = BVAL_FALSE;
 	if (value) str = BVAL_TRUE;
 	return _emit(name.c_str(), CTYPE_BOOL, str, TYPE_TRIGGER);
 }
 
-/*bool HomeyClass::setCapabilityValue(const String& name, bool emit)
+/*bool HomeyDevice::setCapabilityValue(const String& name, bool emit)
 {
 	if (!emit) {
 		_setValue(name.c_str(), CTYPE_NULL, "null", TYPE_CAPABILITY);
@@ -143,7 +233,7 @@ bool HomeyClass::trigger(const String& name, bool value)
 	}
 	return _emit(name.c_str(), CTYPE_NULL, "null", TYPE_CAPABILITY);
 }*/
-bool HomeyClass::setCapabilityValue(const String& name, const char* value, bool emit)
+bool HomeyDevice::setCapabilityValue(const String& name, const char* value, bool emit)
 {
 	if (!emit) {
 		_setValue(name.c_str(), CTYPE_STRING, "\""+String(value)+"\"", TYPE_CAPABILITY);
@@ -151,7 +241,7 @@ bool HomeyClass::setCapabilityValue(const String& name, const char* value, bool
 	}
 	return _emit(name.c_str(), CTYPE_STRING, "\""+String(value)+"\"", TYPE_CAPABILITY);
 }
-bool HomeyClass::setCapabilityValue(const String& name, const String& value, bool emit)
+bool HomeyDevice::setCapabilityValue(const String& name, const String& value, bool emit)
 {
 	if (!emit) {
 		_setValue(name.c_str(), CTYPE_STRING, "\""+value+"\"", TYPE_CAPABILITY);
@@ -159,7 +249,7 @@ bool HomeyClass::setCapabilityValue(const String& name, const String& value, boo
 	}
 	return _emit(name.c_str(), CTYPE_STRING, "\""+value+"\"", TYPE_CAPABILITY);
 }
-bool HomeyClass::setCapabilityValue(const String& name, int value, bool emit)
+bool HomeyDevice::setCapabilityValue(const String& name, int value, bool emit)
 {
 	if (!emit) {
 		_setValue(name.c_str(), CTYPE_INT, String(value), TYPE_CAPABILITY);
@@ -167,7 +257,7 @@ bool HomeyClass::setCapabilityValue(const String& name, int value, bool emit)
 	}
 	return _emit(name.c_str(), CTYPE_INT, String(value), TYPE_CAPABILITY);
 }
-bool HomeyClass::setCapabilityValue(const String& name, float value, bool emit)
+bool HomeyDevice::setCapabilityValue(const String& name, float value, bool emit)
 {
 	if (!emit) {
 		_setValue(name.c_str(), CTYPE_FLOAT, String(value), TYPE_CAPABILITY);
@@ -176,7 +266,7 @@ bool HomeyClass::setCapabilityValue(const String& name, float value, bool emit)
 	return _emit(name.c_str(), CTYPE_FLOAT, String(value), TYPE_CAPABILITY);
 }
 
-bool HomeyClass::setCapabilityValue(const String& name, double value, bool emit)
+bool HomeyDevice::setCapabilityValue(const String& name, double value, bool emit)
 {
 	if (!emit) {
 		_setValue(name.c_str(), CTYPE_DOUBLE, String(value), TYPE_CAPABILITY);
@@ -185,7 +275,7 @@ bool HomeyClass::setCapabilityValue(const String& name, double value, bool emit)
 	return _emit(name.c_str(), CTYPE_DOUBLE, String(value), TYPE_CAPABILITY);
 }
 
-bool HomeyClass::setCapabilityValue(const String& name, bool value, bool emit)
+bool HomeyDevice::setCapabilityValue(const String& name, bool value, bool emit)
 {
 	String str = BVAL_FALSE;
 	if (value) str = BVAL_TRUE;
@@ -196,33 +286,33 @@ bool HomeyClass::setCapabilityValue(const String& name, bool value, bool emit)
 	return _emit(name.c_str(), CTYPE_BOOL, str, TYPE_CAPABILITY);
 }
 
-bool HomeyClass::emit(const String& name)
+bool HomeyDevice::emit(const String& name)
 {
 	return _emit(name.c_str(), CTYPE_NULL, "null", TYPE_RAW);
 }
-bool HomeyClass::emit(const String& name, const char* value)
+bool HomeyDevice::emit(const String& name, const char* value)
 {
 	return _emit(name.c_str(), CTYPE_STRING, "\""+String(value)+"\"", TYPE_RAW);
 }
-bool HomeyClass::emit(const String& name, const String& value)
+bool HomeyDevice::emit(const String& name, const String& value)
 {
 	return _emit(name.c_str(), CTYPE_STRING, "\""+value+"\"", TYPE_RAW);
 }
-bool HomeyClass::emit(const String& name, int value)
+bool HomeyDevice::emit(const String& name, int value)
 {
 	return _emit(name.c_str(), CTYPE_INT, String(value), TYPE_RAW);
 }
-bool HomeyClass::emit(const String& name, float value)
+bool HomeyDevice::emit(const String& name, float value)
 {
 	return _emit(name.c_str(), CTYPE_FLOAT, String(value), TYPE_RAW);
 }
 
-bool HomeyClass::emit(const String& name, double value)
+bool HomeyDevice::emit(const String& name, double value)
 {
 	return _emit(name.c_str(), CTYPE_FLOAT, String(value), TYPE_RAW);
 }
 
-bool HomeyClass::emit(const String& name, bool value)
+bool HomeyDevice::emit(const String& name, bool value)
 {
 	String str = BVAL_FALSE;
 	if (value) str = BVAL_TRUE;
@@ -293,6 +383,25 @@ void HomeyClass::returnResult(double result)
 	returnResult(String(result), CTYPE_DOUBLE);
 }
 
+bool HomeyClass::beginDatagram(const IPAddress& host, uint16_t port, uint16_t localPort)
+{
+	if (_datagram==NULL) {
+		_datagram = new HomeyDatagram(localPort);
+		if (_datagram==NULL) { DEBUG_PRINTLN("Alloc error for datagram"); return false; }
+	}
+	return _datagram->begin(host, port);
+}
+
+void HomeyClass::stopDatagram()
+{
+	if (_datagram!=NULL) _datagram->stop();
+}
+
+HomeyDatagram* HomeyClass::datagram()
+{
+	return _datagram;
+}
+
 bool HomeyClass::loop()
 {
 	bool result = false;
@@ -300,6 +409,7 @@ bool HomeyClass::loop()
 	yield();
 	while (handleTcp()) { yield(); result = true; }
 	yield();
+	if ((_datagram!=NULL) && (_datagram->loop())) result = true;
 	return result;
 }
 
@@ -311,6 +421,44 @@ String HomeyClass::rqEndpoint() {
 	return _request.endpoint;
 }
 
+HomeyDevice* HomeyClass::rqDevice() {
+	return _requestDevice;
+}
+
+#if defined(HOMEY_USE_POSIX)
+void HomeyClass::setLocalAddress(const IPAddress& address) {
+	_localAddress = address;
+	_tcpServer.setAddress(address);
+}
+
+int HomeyClass::tcpDescriptor() {
+	return _tcpServer.fd();
+}
+
+int HomeyClass::udpDescriptor() {
+	return _udpServer.fd();
+}
+#endif
+
+HomeyServerStats& HomeyClass::stats() {
+	return _stats;
+}
+
+HomeyEmitTable& HomeyClass::emitStats() {
+	return _emitStats;
+}
+
+void HomeyClass::resetStats() {
+	_stats.reset();
+	_emitStats.reset();
+	HomeyDevice* device = this;
+	while (device!=NULL) {
+		HomeyFunction* item = device->firstHomeyFunction;
+		while (item!=NULL) { item->stats.reset(); item = item->nextFunction; }
+		device = (device==this) ? firstDevice : device->nextDevice;
+	}
+}
+
 /* PRIVATE FUNCTIONS */
 
 bool HomeyClass::split(char* buffer, char*& a, char*& b, char separator, uint16_t size)
@@ -329,7 +477,7 @@ bool HomeyClass::split(char* buffer, char*& a, char*& b, char separator, uint16_
 	return false; //Separator not found in buffer
 }
 
-char* HomeyClass::copyCharArray(const char* input, uint16_t maxlen)
+char* HomeyDevice::copyCharArray(const char* input, uint16_t maxlen)
 {
 	uint16_t size = strnlen(input, maxlen)+1;
 	if (size>=maxlen) return NULL;
@@ -443,7 +591,7 @@ bool HomeyClass::parseHttpHeaders(CLIENT_TYPE* client) {
 	return true;
 }
 
-bool HomeyClass::on(const char* name, const char* type, CallbackFunction cb, bool needsValue) {
+bool HomeyDevice::on(const char* name, const char* type, CallbackFunction cb, bool needsValue, const HomeyDelegate& delegate) {
 	//if (cb==NULL) {DEBUG_PRINTLN("Callback is null"); return false; }
 
 	char* newType = copyCharArray(type, MAX_TYPE_LENGTH);
@@ -459,6 +607,7 @@ bool HomeyClass::on(const char* name, const char* type, CallbackFunction cb, boo
 		free(newName);
 		return false;
 	}
+	newFunction->delegate = delegate;
 
 	if (firstHomeyFunction==NULL) {
 		firstHomeyFunction = newFunction;
@@ -472,12 +621,12 @@ bool HomeyClass::on(const char* name, const char* type, CallbackFunction cb, boo
 	return true;
 }
 
-bool HomeyClass::on(const String& name, const String& type, CallbackFunction fn)
+bool HomeyDevice::on(const String& name, const String& type, CallbackFunction fn)
 {
 	return on(name.c_str(), type.c_str(), fn);
 }
 
-HomeyFunction* HomeyClass::find(const char* name, const char* type)
+HomeyFunction* HomeyDevice::find(const char* name, const char* type)
 {
 	HomeyFunction *item = firstHomeyFunction;
 
@@ -502,7 +651,7 @@ HomeyFunction* HomeyClass::find(const char* name, const char* type)
 	return NULL;												//Not found
 }
 
-bool HomeyClass::remove(const char* name, const char* type)
+bool HomeyDevice::remove(const char* name, const char* type)
 {	//Removes an action or condition
 	HomeyFunction* func = find(name, type);
 	if (func==NULL) return false;
@@ -526,7 +675,28 @@ bool HomeyClass::remove(const char* name, const char* type)
 	return true;
 }
 
+HomeyDevice* HomeyClass::routeRequest() {
+	//Requests for additional devices start with "/<id>", everything else is for this device
+	HomeyDevice* device = firstDevice;
+	while (device!=NULL) {
+		uint16_t length = device->_deviceName.length();
+		if ((_request.endpoint.length()>length) &&
+			(strncmp(_request.endpoint.c_str()+1, device->_deviceName.c_str(), length)==0)) {
+			char next = _request.endpoint.charAt(length+1);
+			if ((next=='/') || (next==0)) {
+				_request.endpoint.remove(0, length+1);
+				if (_request.endpoint=="") _request.endpoint = "/";
+				return device;
+			}
+		}
+		device = device->nextDevice;
+	}
+	return this;
+}
+
 void HomeyClass::handleRequest() {
+	HomeyDevice* device = _requestDevice = routeRequest();
+
 	if (_request.endpoint=="") {
 		DEBUG_PRINTLN("invalid request");
 		returnError("Invalid request", 400);
@@ -546,12 +716,32 @@ void HomeyClass::handleRequest() {
 		String host = arg_h;
 		uint16_t port = atoi(arg_p);
 
-		if ((host=="") || (port<1) || (!_master_host.fromString(host) || (!success))) {
+		if ((host=="") || (port<1) || (!device->_master_host.fromString(host) || (!success))) {
 			return returnError("invalid argument", 400);
 		}
-		_master_port = port;
+		device->_master_port = port;
 		returnResult((bool) true);
 		DEBUG_PRINTLN("Master set to "+host+":"+String(port));
+	} else if (_request.endpoint==STE_ENDPOINT) {
+		DEBUG_PRINTLN("emit stats request");
+		if (_request.isPost) { //POST clears the statistics
+			_emitStats.reset();
+			returnResult((bool) true);
+		} else {
+			_response.code = 3; //(hack, returns actual statistics elsewhere)
+			_response.response = "";
+			_response.type = CTYPE_NULL;
+		}
+	} else if (_request.endpoint==STS_ENDPOINT) {
+		DEBUG_PRINTLN("stats request");
+		if (_request.isPost) { //POST clears the statistics
+			resetStats();
+			returnResult((bool) true);
+		} else {
+			_response.code = 2; //(hack, returns actual statistics elsewhere)
+			_response.response = "";
+			_response.type = CTYPE_NULL;
+		}
 	} else {
 		DEBUG_PRINTLN("api request");
 		_request.endpoint.remove(0,1); //Remove first "/" from endpoint
@@ -567,26 +757,24 @@ void HomeyClass::handleRequest() {
 		DEBUG_PRINT("' of type '");
 		DEBUG_PRINT(type);
 		DEBUG_PRINTLN("'...");
-		HomeyFunction* function = find(name.c_str(), type.c_str());
+		HomeyFunction* function = device->find(name.c_str(), type.c_str());
+
+		_requestFunction = function;
 
 		if (function==NULL) {
 			returnError("not found", 404);
 		} else if (_request.isPost) { //POST request
-			if (function->callback==NULL) {
+			if ((function->callback==NULL) && (!function->delegate.valid())) {
 				returnError("not setable", 400);
 			} else {
-				value = _request.args;
-				returnNothing(); //Leave the answer up to the callback
-				function->callback();
+				runCallback(function);
 			}
 		} else { //GET request
 			if (function->value==NULL) { //Try returning the current value first (used for capabilities)
-				if (function->callback==NULL) {
+				if ((function->callback==NULL) && (!function->delegate.valid())) {
 					returnError("not getable", 400); //Return error
 				} else { //Else try to run the callback
-					value = _request.args;
-					returnNothing(); //Leave the answer up to the callback
-					function->callback();
+					runCallback(function);
 				}
 			} else {
 				returnResult(*(function->value), *(function->valueType));
@@ -605,10 +793,25 @@ bool HomeyClass::handleTcp() {
 		t--;
 	}
 
+	return handleClient(client);
+}
+
+bool HomeyClass::handleClient(CLIENT_TYPE& client) {
 	if (client) {
+		unsigned long started = micros();
 		bool valid = parseHttpHeaders(&client);
+		unsigned long parsed = micros();
+		unsigned long writeStarted = parsed;
+		unsigned long written = parsed;
+		uint16_t code = 0;
+		_requestDevice = this;
+		_requestFunction = NULL;
+		_callbackUs = 0;
+		if (!valid) _stats.parseErrors.fetch_add(1, std::memory_order_relaxed);
 		if (client.connected()) {
 			bool sendIndex = false;
+			bool sendStats = false;
+			bool sendEmitStats = false;
 			if (!valid) {
 				returnError("Could not parse request", 400);
 			} else {
@@ -626,6 +829,12 @@ bool HomeyClass::handleTcp() {
 				if (_response.code==1) {
 					sendIndex = true;
 					_response.code = 200;
+				} else if (_response.code==2) {
+					sendStats = true;
+					_response.code = 200;
+				} else if (_response.code==3) {
+					sendEmitStats = true;
+					_response.code = 200;
 				}
 			}
 
@@ -643,6 +852,7 @@ bool HomeyClass::handleTcp() {
 				desc = "OK";
 			}
 
+			writeStarted = micros();
 			client.print("HTTP/1.1 ");
 			client.print(_response.code);
 			client.print(' ');
@@ -652,7 +862,11 @@ bool HomeyClass::handleTcp() {
 			client.println();
 
 			if (sendIndex) {
-				streamWriteIndex(&client);
+				streamWriteIndex(&client, _requestDevice);
+			} else if (sendStats) {
+				streamWriteStats(&client, _requestDevice);
+			} else if (sendEmitStats) {
+				streamWriteEmitStats(&client);
 			} else {
 				client.print("{\"t\":\"");
 				client.print(_response.type);
@@ -661,26 +875,54 @@ bool HomeyClass::handleTcp() {
 				client.print(_response.response);
 				client.print("}");
 			}
+			code = _response.code;
+			written = micros();
 		}
 		client.stop();
+		HomeyEndpointStats& stats = (_requestFunction!=NULL) ? _requestFunction->stats : _stats.other;
+		stats.record(code, parsed - started, _callbackUs, written - writeStarted);
 		yield();
 		return true;
 	}
 	return false;
 }
 
+void HomeyClass::runCallback(HomeyFunction* function) {
+	returnNothing(); //Leave the answer up to the callback
+	unsigned long started = micros();
+	if (function->delegate.valid()) {
+		//Typed callbacks get the argument parsed in place, without copying it into value
+		HomeyArgument argument;
+		if (!homeyParseArgument(function->delegate.argumentType(), _request.args.c_str(), _request.args.length(), argument)) {
+			return returnError("invalid argument", 400);
+		}
+		function->delegate(argument);
+	} else {
+		value = _request.args;
+		function->callback();
+	}
+	_callbackUs = micros() - started;
+}
+
 void HomeyClass::streamFlush(Stream* s) {
 	///DEBUG_PRINT("Flushing message: ");
 	while(s->available()) s->read(); //DEBUG_PRINT((char) s->read()); //Read until EOF
 	//DEBUG_PRINTLN();
 }
 
-void HomeyClass::streamWriteIndex(Stream* s) {
+void HomeyClass::streamWriteIndex(Stream* s, HomeyDevice* device) {
 	//Id field
 	s->print("{\"id\":\"");
-	s->print(_deviceName);
+	s->print(device->_deviceName);
 	s->print('"');
 
+	//Path prefix of additional devices (an extension, the Homeyduino app does not read it)
+	if (device!=this) {
+		s->print(",\"path\":\"/");
+		s->print(device->_deviceName);
+		s->print('"');
+	}
+
 	//Version
 	s->print(",\"version\":\"" HOMEYDUINO_VERSION "\"");
 
@@ -691,11 +933,11 @@ void HomeyClass::streamWriteIndex(Stream* s) {
 
 	//Class field
 	s->print(",\"class\":\"");
-	s->print(_deviceClass);
+	s->print(device->_deviceClass);
 	s->print('"');
 
 	//RC field
-	if (rcEnabled) {
+	if ((device==this) && (rcEnabled)) {
 		s->print(",\"rc\":{");
 		s->print("\"arch\":\"");
 		s->print(arduino_arch);
@@ -714,15 +956,15 @@ void HomeyClass::streamWriteIndex(Stream* s) {
 
 	//Master field
 	s->print(",\"master\":{\"host\":\"");
-	s->print(_master_host);
+	s->print(device->_master_host);
 	s->print("\", \"port\":");
-	s->print(_master_port);
+	s->print(device->_master_port);
 	s->print('}');
 
 	//Api field
 	s->print(",\"api\":[");
 	uint16_t i = 0;
-	HomeyFunction *item = firstHomeyFunction;
+	HomeyFunction *item = device->firstHomeyFunction;
 	while (item!=NULL) {
 		s->print("{\"name\":\"");
 		s->print(item->name);
@@ -736,6 +978,97 @@ void HomeyClass::streamWriteIndex(Stream* s) {
 	s->print("]}");
 }
 
+void HomeyClass::streamWriteStats(Stream* s, HomeyDevice* device) {
+	s->print("{\"id\":\"");
+	s->print(device->_deviceName);
+	s->print("\",\"uptime\":");
+	s->print(millis());
+	s->print(",\"bucketBaseUs\":");
+	s->print(STATS_BUCKET_BASE_US);
+
+	//Server wide counters
+	s->print(",\"parseErrors\":");
+	s->print(_stats.parseErrors.load(std::memory_order_relaxed));
+	s->print(",\"discoveries\":");
+	s->print(_stats.discoveries.load(std::memory_order_relaxed));
+	s->print(",\"other\":{");
+	_stats.other.streamWrite(s);
+	s->print('}');
+
+	//Remote configuration triggers
+	if ((device==this) && (rcEnabled)) {
+		s->print(",\"rc\":{");
+		rcTriggerStreamWrite(s);
+		s->print('}');
+	}
+
+	//Endpoints of the addressed device
+	s->print(",\"api\":[");
+	HomeyFunction *item = device->firstHomeyFunction;
+	while (item!=NULL) {
+		s->print("{\"name\":\"");
+		s->print(item->name);
+		s->print("\",\"type\":\"");
+		s->print(item->type);
+		s->print("\",");
+		item->stats.streamWrite(s);
+		s->print('}');
+		item = item->nextFunction;
+		if (item!=NULL) s->print(',');
+	}
+	s->print("]}");
+}
+
+void HomeyClass::streamWriteEmitStats(Stream* s) {
+	s->print("{\"uptime\":");
+	s->print(millis());
+	s->print(",\"bucketBaseUs\":");
+	s->print(STATS_BUCKET_BASE_US);
+	s->print(",\"all\":{");
+	_emitStats.all.streamWrite(s);
+
+	//Per event
+	s->print("},\"events\":[");
+	bool first = true;
+	for (uint8_t i = 0; i<STATS_EMIT_EVENTS; i++) {
+		HomeyEmitEvent& event = _emitStats.events[i];
+		if (event.device==NULL) continue;
+		if (!first) s->print(',');
+		first = false;
+		s->print("{\"device\":\"");
+		s->print(((HomeyDevice*) event.device)->_deviceName);
+		s->print("\",\"type\":\"");
+		s->print(event.type);
+		s->print("\",\"name\":\"");
+		s->print(event.name);
+		s->print("\",");
+		event.stats.streamWrite(s);
+		s->print('}');
+	}
+	s->print("],\"otherEvents\":{");
+	_emitStats.otherEvents.streamWrite(s);
+
+	//Per master
+	s->print("},\"masters\":[");
+	first = true;
+	for (uint8_t i = 0; i<STATS_EMIT_MASTERS; i++) {
+		HomeyEmitMaster& master = _emitStats.masters[i];
+		if (!master.used) break;
+		if (!first) s->print(',');
+		first = false;
+		s->print("{\"host\":\"");
+		s->print(master.host);
+		s->print("\",\"port\":");
+		s->print(master.port);
+		s->print(',');
+		master.stats.streamWrite(s);
+		s->print('}');
+	}
+	s->print("],\"otherMasters\":{");
+	_emitStats.otherMasters.streamWrite(s);
+	s->print("}}");
+}
+
 /*void HomeyClass::streamWriteIndex(Stream* s) {
 	s->print("{\"id\":\"");
 	s->print(_deviceName);
@@ -778,15 +1111,24 @@ bool HomeyClass::handleUdp() {
 	int packetSize = _udpServer.parsePacket();
 	if (packetSize) {
 		streamFlush(&_udpServer);
-		_udpServer.beginPacket(_udpServer.remoteIP(), _udpServer.remotePort());
-		streamWriteIndex(&_udpServer);
-		_udpServer.endPacket();
+		answerDiscovery(_udpServer.remoteIP(), _udpServer.remotePort());
 		return true;
 	}
 	return false;
 }
 
-void HomeyClass::_setValue(const char* name, const char* argType, const String& triggerValue, const char* evType) {
+void HomeyClass::answerDiscovery(const IPAddress& host, uint16_t port) {
+	_stats.discoveries.fetch_add(1, std::memory_order_relaxed);
+	HomeyDevice* device = this;
+	while (device!=NULL) { //Answer the discovery for every device hosted here
+		_udpServer.beginPacket(host, port);
+		streamWriteIndex(&_udpServer, device);
+		_udpServer.endPacket();
+		device = (device==this) ? firstDevice : device->nextDevice;
+	}
+}
+
+void HomeyDevice::_setValue(const char* name, const char* argType, const String& triggerValue, const char* evType) {
 	HomeyFunction* function = find(name, evType);
 	if (function!=NULL) {
 		if (function->value!=NULL) {
@@ -796,36 +1138,57 @@ void HomeyClass::_setValue(const char* name, const char* argType, const String&
 	}
 }
 
-bool HomeyClass::_emit(const char* name, const char* argType, const String& triggerValue, const char* evType) {
+bool HomeyDevice::_emit(const char* name, const char* argType, const String& triggerValue, const char* evType) {
+	return _homey->_emit(this, name, argType, triggerValue, evType);
+}
+
+bool HomeyClass::_emit(HomeyDevice* device, const char* name, const char* argType, const String& triggerValue, const char* evType) {
+	unsigned long started = micros();
 
 	/* Give OS control first */
 	yield();
 
 	/*Set value if corresponding API call exists and has value storage enabled */
-	_setValue(name, argType, triggerValue, evType);
+	device->_setValue(name, argType, triggerValue, evType);
+
+	/* Send as a datagram when that transport has been started */
+	if ((_datagram!=NULL) && (_datagram->active())) {
+		const char* deviceId = (device!=this) ? device->_deviceName.c_str() : ""; //Tells the receiver which device sent it
+		bool queued = _datagram->send(evType, deviceId, name, argType, triggerValue);
+		uint32_t bytes = DATAGRAM_HEADER_SIZE + strlen(evType) + strlen(deviceId) + strlen(name) + 4 + triggerValue.length();
+		recordEmit(device, name, evType, _datagram->host(), _datagram->port(),
+			queued ? STATS_EMIT_OK : STATS_EMIT_REJECTED, queued ? bytes : 0, 0, 0, started);
+		return queued;
+	}
 
 	/* Check if master has been configured */
-	if (_master_host[0]==0) return false;
+	if (device->_master_host[0]==0) {
+		recordEmit(device, name, evType, device->_master_host, 0, STATS_EMIT_NO_MASTER, 0, 0, 0, started);
+		return false;
+	}
 
 	/* Execute request */
 	CLIENT_TYPE client;
-	if (client.connect(_master_host, _master_port)) {
-		client.print("POST /emit/");
-		client.print(evType);
-		client.print('/');
-		client.print(name);
-		client.println(" HTTP/1.1");
-		client.println("Content-Type: application/json");
-		client.println("Connection: close");
-		client.print("Content-Length: ");
-		client.println(9+13+2+strlen(argType)+triggerValue.length());
-
-		client.println();
-		client.print("{\"type\":\""); //9
-		client.print(argType);
-		client.print("\",\"argument\":"); //13
-		client.print(triggerValue);
-		client.println('}'); //2
+	if (client.connect(device->_master_host, device->_master_port)) {
+		uint32_t connectUs = micros() - started;
+		uint32_t bytes = 0;
+		bytes += client.print("POST /emit/");
+		bytes += client.print(evType);
+		bytes += client.print('/');
+		bytes += client.print(name);
+		bytes += client.println(" HTTP/1.1");
+		bytes += client.println("Content-Type: application/json");
+		bytes += client.println("Connection: close");
+		bytes += client.print("Content-Length: ");
+		bytes += client.println(9+13+2+strlen(argType)+triggerValue.length());
+
+		bytes += client.println();
+		bytes += client.print("{\"type\":\""); //9
+		bytes += client.print(argType);
+		bytes += client.print("\",\"argument\":"); //13
+		bytes += client.print(triggerValue);
+		bytes += client.println('}'); //2
+		unsigned long requestSent = micros();
 
 		uint8_t timeout = 200;
 		while (client.available()==0) {
@@ -833,19 +1196,32 @@ bool HomeyClass::_emit(const char* name, const char* argType, const String& trig
 			timeout--;
 			if (timeout<1) break;
 		}
+		bool answered = (client.available()>0);
+		uint32_t firstByteUs = answered ? micros() - requestSent : 0;
 
 		//streamFlush(client); //Flush response
 		//(EthernetClient does not support cast to Stream...)
 		while(client.available()) client.read(); //Flush response
 
 		client.stop();
+		recordEmit(device, name, evType, device->_master_host, device->_master_port,
+			answered ? STATS_EMIT_OK : STATS_EMIT_TIMEOUT, bytes, connectUs, firstByteUs, started);
 		yield();
 		return true;
 	}
+	recordEmit(device, name, evType, device->_master_host, device->_master_port, STATS_EMIT_CONNECT, 0, 0, 0, started);
 	yield();
 	return false;
 }
 
+void HomeyClass::recordEmit(HomeyDevice* device, const char* name, const char* evType, const IPAddress& host, uint16_t port,
+	uint8_t result, uint32_t bytes, uint32_t connectUs, uint32_t firstByteUs, unsigned long started) {
+	uint32_t totalUs = micros() - started;
+	_emitStats.event(device, evType, name).record(result, bytes, connectUs, firstByteUs, totalUs);
+	if (port>0) _emitStats.master(host, port).record(result, bytes, connectUs, firstByteUs, totalUs);
+	_emitStats.all.record(result, bytes, connectUs, firstByteUs, totalUs);
+}
+
 /* STRUCT CONSTRUCTORS */
 
 HomeyFunction::HomeyFunction(char* newName, char* newType, CallbackFunction newCallback, bool needsValue)
@@ -868,7 +1244,6 @@ HomeyFunction::HomeyFunction(char* newName, char* newType, CallbackFunction newC
 HomeyClass Homey;
 
 /* REMOTE CONFIGURATION */
-unsigned long rcLoopPrevMillis = 0;
 
 void HomeyRemoteConfigurationSetup(const String& name)
 {
@@ -879,9 +1254,5 @@ void HomeyRemoteConfigurationSetup(const String& name)
 void HomeyRemoteConfigurationLoop()
 {
 	Homey.loop();
-	unsigned long currentMillis = millis();
-	if(currentMillis - rcLoopPrevMillis > RC_LOOP_INTERVAL) {
-		rcLoopPrevMillis = currentMillis;
-		rcTriggerRun(); //Run RC triggers
-	}
+	rcTriggerRun(); //Run RC triggers
 }
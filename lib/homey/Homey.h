@@ -8,11 +8,22 @@
 // Settings
 //#define HOMEY_USE_ETHERNET_V1 //Uncomment when using a legacy ethernet shield
 //#define DEBUG_ENABLE //Uncomment to have the library print debug messages
+//#define HOMEY_USE_POSIX //Build for Linux with BSD sockets (add lib/homey/posix to the include path)
 
 // Advanced settings
 #define DEBUG_PRINTER		Serial			//Which class to use for printing debug mesages
 #define DEVICE_TYPE		 	"homeyduino"	//Device type
-#define RC_LOOP_INTERVAL	500
+#define RC_TRIGGER_MAX		16				//Number of pins that can be registered as trigger
+#define RC_EDGE_QUEUE		32				//Digital edges buffered between interrupt and loop (power of two)
+#define RC_ANALOG_INTERVAL	10				//Milliseconds between two samples of the analog trigger pins
+#define RC_ANALOG_SAMPLES	8				//Samples averaged into one analog value
+#define RC_ANALOG_DEADBAND	16				//Minimum change of the average before an analog trigger fires
+#define RC_ANALOG_MIN_INTERVAL	250			//Minimum milliseconds between two triggers of one analog pin
+#define RC_PIN_CACHE_SIZE	16				//Number of resolved pin names remembered by the RC endpoints
+#define DATAGRAM_LOCAL_PORT	46640			//Local port used by the datagram transport (acks arrive here)
+#define DATAGRAM_WINDOW		8				//Maximum number of unacknowledged datagram events
+#define DATAGRAM_RETRY_INTERVAL	40			//Initial retransmission timeout in ms (doubles per retry)
+#define DATAGRAM_MAX_RETRIES	4				//Retransmissions before an event is given up
 
 /* -------------- DO NOT EDIT ANYTHING BELOW THIS LINE!  -------------- */
 /* (If you do you might break compatibility with the Homeyduino app...) */
@@ -49,11 +60,20 @@
 #define DCLASS_OTHER		"other"
 
 #define SME_ENDPOINT		"/sys/setmaster"
+#define STS_ENDPOINT		"/sys/stats"
+#define STE_ENDPOINT		"/sys/emitstats"
 
 //Includes
 #include <Arduino.h>
 
-#if defined(ARDUINO_ARCH_ESP8266)
+#if defined(HOMEY_USE_POSIX)
+	#include "posix/HomeyPosix.h"
+	#define CLIENT_TYPE PosixClient
+	#define UDP_SERVER_TYPE PosixUDP
+	#define TCP_SERVER_TYPE PosixServer
+	#define UDP_TX_PACKET_MAX_SIZE 1024
+	#define MAXCALLBACKS 10
+#elif defined(ARDUINO_ARCH_ESP8266)
 	#include <ESP8266WiFi.h>
 	#include <WiFiClient.h>
 	#include <WiFiUdp.h>
@@ -96,6 +116,10 @@
   #define DEBUG_PRINTLN(...) {}
 #endif
 
+#include "HomeyDatagram.h"
+#include "HomeyStats.h"
+#include "HomeyDelegate.h"
+
 //Type definitions
 typedef void (*CallbackFunction)(void);
 
@@ -109,6 +133,8 @@ struct HomeyFunction {
 	String* valueType;						//Type of value (if needed)
 	String* value;								//Value (if needed) (formatted!)
 	CallbackFunction callback;		//Function pointer
+	HomeyDelegate delegate;			//Typed callback (used instead of callback when valid)
+	HomeyEndpointStats stats;		//Request counters and latency histograms
 };
 
 struct WebResponse {
@@ -123,22 +149,26 @@ struct WebRequest {
 	bool isPost; //False: GET, True: POST
 };
 
-class HomeyClass {
+class HomeyClass;
+
+class HomeyDevice {
 	public:
-		//Library and device management
-		HomeyClass( uint16_t port = 46639 ); 									//Class constructor (port 46639 is t9 for HOMEY)
-		void begin(const String& name, const String& type = DEVICE_TYPE);		//Start responding to queries
-		void stop();															//Stop responding to queries
+		//Device management
+		HomeyDevice(HomeyClass* homey, const String& name,						//Class constructor (devices are created through HomeyClass::addDevice)
+				const String& deviceClass = DCLASS_OTHER);
 		String getName();														//Get the current device identifier
 		void setName(const String& deviceName);									//Change the device identifier
 		String getClass();														//Get the current device class
 		void setClass(const String& deviceClass);								//Change the device class
+		void setMaster(const IPAddress& host, uint16_t port);					//Set where events are sent (normally done by Homey through /sys/setmaster)
 
 		//API endpoint management
 		bool addAction(const String& name, CallbackFunction fn);				//Wrapper for on(String&, String&,...) that supplies type as TYPE_ACTION
 		bool addCondition(const String& name, CallbackFunction fn);				//Wrapper for on(String&, String&,...) that supplies type as TYPE_CONDITION
 		bool addCapability(const String& name, CallbackFunction fn = NULL);		//Wrapper for on(String&, String&,...) that supplies type as TYPE_CAPABILITY
-		bool addRc(const String& name, CallbackFunction fn);					//Wrapper for on(String&, String&,...) that supplies type as TYPE_REMOTE
+		bool addAction(const String& name, const HomeyDelegate& fn);			//Register an action with a typed callback
+		bool addCondition(const String& name, const HomeyDelegate& fn);			//Register a condition with a typed callback
+		bool addCapability(const String& name, const HomeyDelegate& fn);		//Register a capability with a typed callback
 		HomeyFunction* findAction(const char* name);							//Wrapper for find(...) that supplies type as TYPE_ACTION
 		HomeyFunction* findCondition(const char* name);							//Wrapper for find(...) that supplies type as TYPE_CONDITION
 		HomeyFunction* findCapability(const char* name);						//Wrapper for find(...) that supplies type as TYPE_CAPABILITY
@@ -176,6 +206,50 @@ class HomeyClass {
 		bool emit(const String& name, float value);								//Wrapper for emit(...) with float argument type set to raw
 		bool emit(const String& name, double value);							//Wrapper for emit(...) with double argument type set to raw
 
+	protected:
+		//Helper functions
+		static char* copyCharArray(const char* input, uint16_t maxlen);		//Allocates memory and copies a char array
+
+		//API endpoint management
+		bool on(const char* name, const char* type, CallbackFunction cb,		//Create an endpoint
+				bool needsValue = false, const HomeyDelegate& delegate = HomeyDelegate());
+		bool on(const String& name, const String& type, CallbackFunction fn);	//Wrapper for on(char*,char*,...) to allow for supplying string arguments
+		HomeyFunction* find(const char* name, const char* type);				//Find an endpoint
+		bool remove(const char* name, const char* type);						//Remove an endpoint
+
+		void _setValue(const char* name, const char* argType, const String& triggerValue, const char* evType);
+
+		//Event transmission
+		bool _emit(const char* name, const char* argType, const String& value,	//Emit an event through the HomeyClass that hosts this device
+		const char* evType);
+
+		//Internal variables
+		HomeyClass* _homey;														//The server hosting this device
+		String _deviceName;														//The device identifier
+		String _deviceClass;													//The device class
+		IPAddress _master_host;													//Master IP address
+		uint16_t _master_port;													//Master port
+		HomeyFunction* firstHomeyFunction = NULL;								//API callbacks linked list entry point
+		HomeyDevice* nextDevice = NULL;											//Linked list of additional devices (>)
+
+	friend class HomeyClass;
+};
+
+class HomeyClass : public HomeyDevice {
+	public:
+		//Library and device management
+		HomeyClass( uint16_t port = 46639 ); 									//Class constructor (port 46639 is t9 for HOMEY)
+		void begin(const String& name, const String& type = DEVICE_TYPE);		//Start responding to queries
+		void stop();															//Stop responding to queries
+
+		//Additional devices served from the same sockets (requests are prefixed with "/<id>")
+		HomeyDevice* addDevice(const String& id, const String& deviceClass = DCLASS_OTHER);	//Create a device, returns NULL when the id is invalid or taken
+		HomeyDevice* findDevice(const char* id);								//Find an additional device by id
+		bool removeDevice(const char* id);										//Remove an additional device and its endpoints
+
+		//API endpoint management
+		bool addRc(const String& name, CallbackFunction fn);					//Wrapper for on(String&, String&,...) that supplies type as TYPE_REMOTE
+
 		//Set the answer returned
 		void returnIndex();														//Return the API index
 		void returnNothing();													//Return nothing
@@ -187,10 +261,29 @@ class HomeyClass {
 		void returnResult(float result);										//Return a float
 		void returnResult(double result);										//Return a double
 
+		//Optional low-latency datagram transport for events
+		bool beginDatagram(const IPAddress& host, uint16_t port,				//Send events as UDP datagrams to host:port instead of HTTP to the master
+				uint16_t localPort = DATAGRAM_LOCAL_PORT);						//(acks arrive at localPort, 0: any free port)
+		void stopDatagram();													//Return to sending events over HTTP
+		HomeyDatagram* datagram();												//The datagram transport (NULL when not started)
+
 		//Handle incoming connections
 		bool loop();															//Wrapper that runs both TCP and UDP handlers
 		bool rqType();															//Current request type: GET = false, POST = true
 		String rqEndpoint();											//Current request endpoint
+		HomeyDevice* rqDevice();												//Device addressed by the current request
+		bool handleClient(CLIENT_TYPE& client);								//Answer the request on an accepted connection (for programs that accept themselves)
+		void answerDiscovery(const IPAddress& host, uint16_t port);				//Send the index of every device hosted here to host:port
+#if defined(HOMEY_USE_POSIX)
+		void setLocalAddress(const IPAddress& address);							//Listen on this address only (call before begin)
+		int tcpDescriptor();													//Listening socket, for programs that wait with poll/epoll
+		int udpDescriptor();													//Discovery socket, for programs that wait with poll/epoll
+#endif
+
+		//Request statistics (per endpoint statistics live in HomeyFunction::stats)
+		HomeyServerStats& stats();												//Counters for requests not handled by an endpoint
+		void resetStats();														//Clear the statistics of all devices and endpoints
+		HomeyEmitTable& emitStats();											//Outbound event counters per event, per master and in total
 
 		//Public variables
 		String value;															//The argument supplied by the Homey flow
@@ -200,29 +293,26 @@ class HomeyClass {
 		//Helper functions
 		bool split(char* buffer, char*& a, char*& b, char separator,			//Splits a buffer into separate parts
 		uint16_t size);
-		char* copyCharArray(const char* input, uint16_t maxlen);				//Allocates memory and copies a char array
 		bool parseHttpHeaders(CLIENT_TYPE* client);								//Parse HTTP headers and fill _request
 
-		//API endpoint management
-		bool on(const char* name, const char* type, CallbackFunction cb,		//Create an endpoint
-				bool needsValue = false);
-		bool on(const String& name, const String& type, CallbackFunction fn);	//Wrapper for on(char*,char*,...) to allow for supplying string arguments
-		HomeyFunction* find(const char* name, const char* type);				//Find an endpoint
-		bool remove(const char* name, const char* type);						//Remove an endpoint
-
 		//Request handling
+		HomeyDevice* routeRequest();											//Find the device addressed by _request and strip its prefix
 		void handleRequest();													//Handle API call
+		void runCallback(HomeyFunction* function);								//Run an endpoint callback and time it
 		bool handleTcp();														//Handle incoming TCP connections
 		bool handleUdp();														//Handle incoming UDP connections
 
 		void streamFlush(Stream* s);
-		void streamWriteIndex(Stream* s);
-
-		void _setValue(const char* name, const char* argType, const String& triggerValue, const char* evType);
+		void streamWriteIndex(Stream* s, HomeyDevice* device);
+		void streamWriteStats(Stream* s, HomeyDevice* device);
+		void streamWriteEmitStats(Stream* s);
 
 		//Event transmission
-		bool _emit(const char* name, const char* argType, const String& value,	//Emit an event
-		const char* evType);
+		bool _emit(HomeyDevice* device, const char* name, const char* argType,	//Emit an event on behalf of a device
+		const String& value, const char* evType);
+		void recordEmit(HomeyDevice* device, const char* name,					//Account an emit in the event, master and total statistics
+		const char* evType, const IPAddress& host, uint16_t port, uint8_t result,
+		uint32_t bytes, uint32_t connectUs, uint32_t firstByteUs, unsigned long started);
 
 		//Set the answer returned
 		void returnResult(const String& response, const String& type);			//Set the return value
@@ -231,15 +321,22 @@ class HomeyClass {
 		TCP_SERVER_TYPE _tcpServer;												//The TCP server
 		UDP_SERVER_TYPE _udpServer;												//The UDP server
 		uint16_t _port;															//The listening port for incoming connections
-		String _deviceName;														//The device identifier
 		String _deviceType;														//The device type
-		String _deviceClass;													//The device class
 		HomeyFunction *callbacks[MAXCALLBACKS];									//The registered actions and conditions
 		WebRequest _request;													//API request parameter storage
 		WebResponse _response;													//API response parameter storage
-		IPAddress _master_host;													//Master IP address
-		uint16_t _master_port;													//Master port
-		HomeyFunction* firstHomeyFunction = NULL;								//API callbacks linked list entry point
+		HomeyDevice* _requestDevice = NULL;										//Device addressed by the current request
+		HomeyFunction* _requestFunction = NULL;									//Endpoint handling the current request
+		uint32_t _callbackUs;													//Time spent in the callback of the current request
+		HomeyServerStats _stats;												//Statistics for requests not handled by an endpoint
+		HomeyEmitTable _emitStats;												//Statistics for outbound events
+		HomeyDevice* firstDevice = NULL;										//Additional devices linked list entry point
+		HomeyDatagram* _datagram = NULL;										//Datagram transport (only allocated when used)
+#if defined(HOMEY_USE_POSIX)
+		IPAddress _localAddress;												//Address the sockets are bound to (0.0.0.0: all)
+#endif
+
+	friend class HomeyDevice;
 };
 
 extern HomeyClass Homey;
@@ -0,0 +1,180 @@
+#include "Homey.h"
+
+HomeyDatagram::HomeyDatagram(uint16_t localPort)
+: _udp(), _host(0,0,0,0)
+{
+	_localPort = localPort;
+	_port = 0;
+	_active = false;
+	_session = 0;
+	_sequence = 0;
+	memset(_window, 0, sizeof(_window));
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+bool HomeyDatagram::begin(const IPAddress& host, uint16_t port)
+{
+	if ((host[0]==0) || (port<1)) return false;
+	if (!_active) {
+		if (!_udp.begin(_localPort)) {
+			DEBUG_PRINTLN("datagram: could not open local port");
+			return false;
+		}
+		_session = random(1, 0xFFFF); //New session: the receiver resets its sequence tracking
+		_sequence = 0;
+	}
+	_host = host;
+	_port = port;
+	_active = true;
+	return true;
+}
+
+void HomeyDatagram::stop()
+{
+	if (_active) _udp.stop();
+	_active = false;
+	for (uint8_t i = 0; i<DATAGRAM_WINDOW; i++) _window[i].used = false;
+}
+
+bool HomeyDatagram::active()
+{
+	return _active;
+}
+
+IPAddress HomeyDatagram::host()
+{
+	return _host;
+}
+
+uint16_t HomeyDatagram::port()
+{
+	return _port;
+}
+
+bool HomeyDatagram::send(const char* evType, const char* device, const char* name, const char* argType, const String& value)
+{
+	if (!_active) return false;
+
+	Slot* slot = NULL;
+	for (uint8_t i = 0; i<DATAGRAM_WINDOW; i++) {
+		if (!_window[i].used) { slot = &_window[i]; break; }
+	}
+	if (slot==NULL) {
+		DEBUG_PRINTLN("datagram: window full");
+		_stats.overflows++;
+		return false;
+	}
+
+	uint16_t typeLength = strnlen(evType, MAX_TYPE_LENGTH);
+	uint16_t deviceLength = strnlen(device, MAX_NAME_LENGTH);
+	uint16_t nameLength = strnlen(name, MAX_NAME_LENGTH);
+	if ((typeLength>=MAX_TYPE_LENGTH) || (deviceLength>=MAX_NAME_LENGTH) || (nameLength>=MAX_NAME_LENGTH)) {
+		DEBUG_PRINTLN("datagram: name too long"); //Rejected rather than cut, a cut name is another event
+		return false;
+	}
+	uint16_t size = DATAGRAM_HEADER_SIZE + typeLength + 1 + deviceLength + 1 + nameLength + 1 + 1 + value.length();
+	if (size>DATAGRAM_MAX_SIZE) {
+		DEBUG_PRINTLN("datagram: event too large");
+		return false;
+	}
+
+	_sequence++;
+	uint8_t* p = slot->data;
+	*p++ = DATAGRAM_MAGIC;
+	*p++ = (DATAGRAM_VERSION<<4) | DATAGRAM_KIND_EVENT;
+	*p++ = _session>>8;
+	*p++ = _session&0xFF;
+	*p++ = _sequence>>8;
+	*p++ = _sequence&0xFF;
+	memcpy(p, evType, typeLength); p += typeLength; *p++ = 0;
+	memcpy(p, device, deviceLength); p += deviceLength; *p++ = 0;
+	memcpy(p, name, nameLength); p += nameLength; *p++ = 0;
+	*p++ = argType[0];
+	memcpy(p, value.c_str(), value.length());
+
+	slot->used = true;
+	slot->sequence = _sequence;
+	slot->retries = 0;
+	slot->length = size;
+	_stats.sent++;
+	transmit(*slot);
+	return true;
+}
+
+bool HomeyDatagram::loop()
+{
+	if (!_active) return false;
+
+	bool result = false;
+	uint8_t packet[DATAGRAM_ACK_SIZE];
+	int size;
+	while ((size = _udp.parsePacket())>0) {
+		if (_udp.remoteIP()==_host) {
+			_udp.read(packet, DATAGRAM_ACK_SIZE);
+			handleAck(packet, size);
+		}
+		while (_udp.available()) _udp.read(); //Discard anything else
+		result = true;
+	}
+
+	unsigned long now = millis();
+	for (uint8_t i = 0; i<DATAGRAM_WINDOW; i++) {
+		Slot& slot = _window[i];
+		if (!slot.used) continue;
+		if (now - slot.sentAt < ((unsigned long) DATAGRAM_RETRY_INTERVAL << slot.retries)) continue;
+		if (slot.retries>=DATAGRAM_MAX_RETRIES) {
+			DEBUG_PRINT("datagram: giving up on ");
+			DEBUG_PRINTLN(slot.sequence);
+			slot.used = false;
+			_stats.gaps++;
+			continue;
+		}
+		slot.retries++;
+		_stats.retransmits++;
+		transmit(slot);
+		result = true;
+	}
+	return result;
+}
+
+uint8_t HomeyDatagram::pending()
+{
+	uint8_t count = 0;
+	for (uint8_t i = 0; i<DATAGRAM_WINDOW; i++) {
+		if (_window[i].used) count++;
+	}
+	return count;
+}
+
+const HomeyDatagramStats& HomeyDatagram::stats()
+{
+	return _stats;
+}
+
+void HomeyDatagram::transmit(Slot& slot)
+{
+	_udp.beginPacket(_host, _port);
+	_udp.write(slot.data, slot.length);
+	_udp.endPacket();
+	slot.sentAt = millis();
+	_stats.transmitted++;
+}
+
+void HomeyDatagram::handleAck(const uint8_t* packet, int size)
+{
+	if (size!=DATAGRAM_ACK_SIZE) return; //Events or garbage from the receiver's address
+	if ((packet[0]!=DATAGRAM_MAGIC) || (packet[1]!=((DATAGRAM_VERSION<<4) | DATAGRAM_KIND_ACK))) return;
+	if (((packet[2]<<8) | packet[3])!=_session) return; //Ack for a previous boot
+
+	uint16_t sequence = (packet[4]<<8) | packet[5];
+	for (uint8_t i = 0; i<DATAGRAM_WINDOW; i++) {
+		Slot& slot = _window[i];
+		if ((slot.used) && (slot.sequence==sequence)) {
+			slot.used = false;
+			_stats.acked++;
+			if (packet[6]==DATAGRAM_ACK_DUPLICATE) _stats.duplicates++;
+			return;
+		}
+	}
+	_stats.stray++; //Late ack for an event that was already acked or given up
+}
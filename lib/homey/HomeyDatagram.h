@@ -0,0 +1,77 @@
+#ifndef __HOMEY_DATAGRAM__
+	#define __HOMEY_DATAGRAM__
+
+	#include "Homey.h"
+
+	/* Datagram wire format (all multi-byte fields big endian)
+	 *
+	 *  0      magic ('H')
+	 *  1      version (high nibble), kind (low nibble)
+	 *  2..3   session id (random per boot, lets the receiver detect restarts)
+	 *  4..5   sequence number
+	 *
+	 *  Event:  evType '\0' device '\0' name '\0' argType (first character) value (JSON, as sent over HTTP)
+ *          (device is the id of an additional device, empty for the primary one)
+	 *  Ack:    status (0 = accepted, 1 = duplicate)
+	 */
+
+	#define DATAGRAM_MAGIC			'H'
+	#define DATAGRAM_VERSION		2
+	#define DATAGRAM_KIND_EVENT		1
+	#define DATAGRAM_KIND_ACK		2
+	#define DATAGRAM_HEADER_SIZE	6
+	#define DATAGRAM_ACK_SIZE		DATAGRAM_HEADER_SIZE+1
+	#define DATAGRAM_MAX_SIZE		DATAGRAM_HEADER_SIZE+MAX_TYPE_LENGTH+2*MAX_NAME_LENGTH+1+ARGUMENT_MAX_SIZE
+
+	#define DATAGRAM_ACK_ACCEPTED	0
+	#define DATAGRAM_ACK_DUPLICATE	1
+
+	struct HomeyDatagramStats {
+		uint32_t sent;			//Events accepted by send()
+		uint32_t transmitted;	//Packets put on the wire, including retransmissions
+		uint32_t retransmits;	//Packets sent again after an ack timeout
+		uint32_t acked;			//Events acknowledged by the receiver
+		uint32_t duplicates;	//Acks telling us the receiver had already seen the event
+		uint32_t gaps;			//Events given up after DATAGRAM_MAX_RETRIES (a gap at the receiver)
+		uint32_t overflows;		//Events rejected because the window was full
+		uint32_t stray;			//Acks for sequence numbers that are not pending
+	};
+
+	class HomeyDatagram {
+		public:
+			HomeyDatagram(uint16_t localPort = DATAGRAM_LOCAL_PORT);				//localPort 0 picks a free port when started
+			bool begin(const IPAddress& host, uint16_t port);						//Start sending events to host:port
+			void stop();															//Stop sending and forget pending events
+			bool active();															//True when a destination is configured
+			IPAddress host();														//Destination address
+			uint16_t port();														//Destination port
+			bool send(const char* evType, const char* device, const char* name,	//Queue and transmit an event
+					const char* argType, const String& value);
+			bool loop();															//Handle acks and retransmissions
+			uint8_t pending();														//Number of unacknowledged events
+			const HomeyDatagramStats& stats();										//Transport counters
+
+		private:
+			struct Slot {
+				bool used;
+				uint16_t sequence;
+				uint8_t retries;
+				unsigned long sentAt;
+				uint8_t length;
+				uint8_t data[DATAGRAM_MAX_SIZE];
+			};
+
+			void transmit(Slot& slot);
+			void handleAck(const uint8_t* packet, int size);
+
+			UDP_SERVER_TYPE _udp;
+			uint16_t _localPort;
+			IPAddress _host;
+			uint16_t _port;
+			bool _active;
+			uint16_t _session;
+			uint16_t _sequence;
+			Slot _window[DATAGRAM_WINDOW];
+			HomeyDatagramStats _stats;
+	};
+#endif
@@ -0,0 +1,46 @@
+#include "Homey.h"
+
+bool HomeyStringView::equals(const char* other) const
+{
+	return (strlen(other)==length) && (strncmp(data, other, length)==0);
+}
+
+bool homeyParseArgument(uint8_t type, const char* text, uint16_t length, HomeyArgument& argument)
+{
+	argument.type = type;
+	argument.asInt = 0;
+	argument.asString.data = text;
+	argument.asString.length = length;
+
+	//Numbers are parsed from a terminated copy on the stack, the argument may be longer
+	char number[24];
+	if ((type==ARG_INT) || (type==ARG_FLOAT)) {
+		if ((length<1) || (length>=sizeof(number))) return false;
+		memcpy(number, text, length);
+		number[length] = 0;
+	}
+
+	char* end;
+	switch (type) {
+		case ARG_NONE:
+		case ARG_STRING:
+			return true;
+		case ARG_INT:
+			argument.asInt = strtol(number, &end, 10);
+			return (*end==0);
+		case ARG_FLOAT:
+			argument.asFloat = strtof(number, &end);
+			return (*end==0);
+		case ARG_BOOL:
+			if (argument.asString.equals(BVAL_TRUE) || argument.asString.equals("1")) {
+				argument.asBool = true;
+				return true;
+			}
+			if (argument.asString.equals(BVAL_FALSE) || argument.asString.equals("0")) {
+				argument.asBool = false;
+				return true;
+			}
+			return false;
+	}
+	return false;
+}
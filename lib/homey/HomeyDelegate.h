@@ -0,0 +1,147 @@
+#ifndef __HOMEY_DELEGATE__
+	#define __HOMEY_DELEGATE__
+
+	#include "Homey.h"
+
+	#include <new>
+	#include <type_traits>
+
+	#define DELEGATE_STORAGE_SIZE	(4*sizeof(void*))	//Room for a member function pointer plus object, or a small lambda
+
+	//Argument types a delegate can declare
+	#define ARG_NONE		0
+	#define ARG_INT			1
+	#define ARG_BOOL		2
+	#define ARG_FLOAT		3
+	#define ARG_STRING		4
+
+	//Non-owning view of the argument text; only valid while the callback runs
+	struct HomeyStringView {
+		const char* data;
+		uint16_t length;
+
+		bool equals(const char* other) const;									//Exact comparison with a C string
+	};
+
+	//The request argument, parsed to the type declared by the delegate
+	struct HomeyArgument {
+		uint8_t type;
+		union {
+			long asInt;
+			bool asBool;
+			float asFloat;
+		};
+		HomeyStringView asString;												//Always set: the raw argument text
+	};
+
+	bool homeyParseArgument(uint8_t type, const char* text, uint16_t length,	//Parse text into argument, false when it does not match type
+			HomeyArgument& argument);
+
+	template<typename Arg> struct HomeyArgumentTraits;
+
+	template<> struct HomeyArgumentTraits<void> {
+		static const uint8_t type = ARG_NONE;
+		template<typename F> static void call(F& fn, const HomeyArgument&) { fn(); }
+	};
+
+	template<> struct HomeyArgumentTraits<int> {
+		static const uint8_t type = ARG_INT;
+		template<typename F> static void call(F& fn, const HomeyArgument& a) { fn((int) a.asInt); }
+	};
+
+	template<> struct HomeyArgumentTraits<long> {
+		static const uint8_t type = ARG_INT;
+		template<typename F> static void call(F& fn, const HomeyArgument& a) { fn(a.asInt); }
+	};
+
+	template<> struct HomeyArgumentTraits<bool> {
+		static const uint8_t type = ARG_BOOL;
+		template<typename F> static void call(F& fn, const HomeyArgument& a) { fn(a.asBool); }
+	};
+
+	template<> struct HomeyArgumentTraits<float> {
+		static const uint8_t type = ARG_FLOAT;
+		template<typename F> static void call(F& fn, const HomeyArgument& a) { fn(a.asFloat); }
+	};
+
+	template<> struct HomeyArgumentTraits<HomeyStringView> {
+		static const uint8_t type = ARG_STRING;
+		template<typename F> static void call(F& fn, const HomeyArgument& a) { fn(a.asString); }
+	};
+
+	//A callback that carries its own context in a fixed inline buffer (no heap)
+	//and receives the request argument already parsed to a declared type:
+	//
+	//  Homey.addAction("Set Level", HomeyDelegate::of<int>([](int level) { ... }));
+	//  Homey.addAction("Set Mode", HomeyDelegate::bind<HomeyStringView>(&keypad, &Keypad::setMode));
+	class HomeyDelegate {
+		public:
+			HomeyDelegate() : _invoke(NULL), _type(ARG_NONE) {}
+
+			//Any small, trivially copyable callable taking Arg (or nothing for void)
+			template<typename Arg, typename F>
+			static HomeyDelegate of(F fn) {
+				static_assert(sizeof(F)<=DELEGATE_STORAGE_SIZE, "callable does not fit in the delegate");
+				static_assert(std::is_trivially_copyable<F>::value, "callable must be trivially copyable");
+				HomeyDelegate delegate;
+				new (delegate._storage) F(fn);
+				delegate._invoke = &invokeCallable<Arg, F>;
+				delegate._type = HomeyArgumentTraits<Arg>::type;
+				return delegate;
+			}
+
+			//A member function called on object
+			template<typename Arg, typename T>
+			static HomeyDelegate bind(T* object, void (T::*method)(Arg)) {
+				return of<Arg>(MemberCall<T, void (T::*)(Arg)>(object, method));
+			}
+
+			template<typename T>
+			static HomeyDelegate bind(T* object, void (T::*method)()) {
+				return of<void>(MemberCall<T, void (T::*)()>(object, method));
+			}
+
+			//A plain function that gets a context pointer
+			template<typename Arg, typename T>
+			static HomeyDelegate bind(T* context, void (*fn)(T*, Arg)) {
+				return of<Arg>(ContextCall<T, void (*)(T*, Arg)>(context, fn));
+			}
+
+			template<typename T>
+			static HomeyDelegate bind(T* context, void (*fn)(T*)) {
+				return of<void>(ContextCall<T, void (*)(T*)>(context, fn));
+			}
+
+			bool valid() const { return _invoke!=NULL; }
+			uint8_t argumentType() const { return _type; }
+			void operator()(const HomeyArgument& argument) { _invoke(_storage, argument); }
+
+		private:
+			typedef void (*Invoker)(void* storage, const HomeyArgument& argument);
+
+			template<typename Arg, typename F>
+			static void invokeCallable(void* storage, const HomeyArgument& argument) {
+				HomeyArgumentTraits<Arg>::call(*reinterpret_cast<F*>(storage), argument);
+			}
+
+			template<typename T, typename M>
+			struct MemberCall {
+				MemberCall(T* o, M m) : object(o), method(m) {}
+				template<typename... A> void operator()(A... a) { (object->*method)(a...); }
+				T* object;
+				M method;
+			};
+
+			template<typename T, typename Fn>
+			struct ContextCall {
+				ContextCall(T* c, Fn f) : context(c), fn(f) {}
+				template<typename... A> void operator()(A... a) { fn(context, a...); }
+				T* context;
+				Fn fn;
+			};
+
+			alignas(void*) unsigned char _storage[DELEGATE_STORAGE_SIZE];
+			Invoker _invoke;
+			uint8_t _type;
+	};
+#endif
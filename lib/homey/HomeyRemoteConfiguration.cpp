@@ -1,15 +1,31 @@
 #include "HomeyRemoteConfiguration.h"
 
-rcTrigger* firstRcTrigger = NULL;
 
 /* Remote configuration */
-uint8_t rcMapPin(String pin)
+rcPinCacheEntry rcPinCache[RC_PIN_CACHE_SIZE];
+uint8_t rcPinCacheNext = 0;
+
+long rcParseNumber(const char* text, uint16_t length)
+{	//Same rules as String::toInt(): leading digits, stops at the first other character
+	bool negative = ((length>0) && (text[0]=='-'));
+	long result = 0;
+	for (uint16_t i = negative ? 1 : 0; (i<length) && isDigit(text[i]); i++) {
+		result = result*10 + (text[i]-'0');
+	}
+	return negative ? -result : result;
+}
+
+uint8_t rcMapPin(const char* pin, uint16_t length)
 {
-	if (!isDigit(pin.charAt(0))) {
+	if (length<1) {
+		DEBUG_PRINTLN("invalid pin type");
+		Homey.returnError("invpt");
+		return 255;
+	}
+	if (!isDigit(pin[0])) {
 		//First character is NOT a digit
-		if ((pin.charAt(0)=='A')||(pin.charAt(0)=='a')) {
-			pin.remove(0,1); //Remove first character
-			uint8_t p = pin.toInt();
+		if ((pin[0]=='A')||(pin[0]=='a')) {
+			uint8_t p = rcParseNumber(pin+1, length-1); //Skip first character
 			if (p>=NUM_ANALOG_INPUTS) {
 				DEBUG_PRINTLN("invalid analog pin");
 				Homey.returnError("invap");
@@ -18,19 +34,18 @@ uint8_t rcMapPin(String pin)
 			return analog_input_map[p]; //Map Ax to corresponding digital pin number
 		}
 		#if defined(_VARIANT_ARDUINO_DUE_X_) //Hack for supporting the special pins on Arduino Due
-			else if(pin=="DAC0") {
+			else if((length==4)&&(strncmp(pin, "DAC0", 4)==0)) {
 				return DAC0;
-			} else if(pin=="DAC1") {
+			} else if((length==4)&&(strncmp(pin, "DAC1", 4)==0)) {
 				return DAC1;
-			} else if(pin=="CANRX") {
+			} else if((length==5)&&(strncmp(pin, "CANRX", 5)==0)) {
 				return CANRX;
-			} else if(pin=="CANTX") {
+			} else if((length==5)&&(strncmp(pin, "CANTX", 5)==0)) {
 				return CANTX;
 			}
 		#endif
-		else if ((pin.charAt(0)=='D')||(pin.charAt(0)=='d')) {
-			pin.remove(0,1); //Remove first character
-			uint8_t p = pin.toInt();
+		else if ((pin[0]=='D')||(pin[0]=='d')) {
+			uint8_t p = rcParseNumber(pin+1, length-1); //Skip first character
 			if (p>=sizeof(digital_pin_map)) {
 				DEBUG_PRINTLN("invalid mapped digital pin");
 				Homey.returnError("invmap");
@@ -43,7 +58,7 @@ uint8_t rcMapPin(String pin)
 			return 255;
 		}
 	} else {
-		uint8_t p = pin.toInt();
+		uint8_t p = rcParseNumber(pin, length);
 		if (p>=NUM_DIGITAL_PINS) {
 			DEBUG_PRINTLN("invalid digital pin");
 			Homey.returnError("invdp");
@@ -55,6 +70,42 @@ uint8_t rcMapPin(String pin)
 	return 255;
 }
 
+uint8_t rcMapPin(String pin)
+{
+	return rcMapPin(pin.c_str(), pin.length());
+}
+
+uint8_t rcResolvePin(const char* pin, uint16_t length)
+{
+	//Pin names are at most a few characters, so they are cached by value
+	bool cacheable = ((length>0) && (length<sizeof(rcPinCache[0].name)));
+	if (cacheable) {
+		for (uint8_t i = 0; i<RC_PIN_CACHE_SIZE; i++) {
+			rcPinCacheEntry& entry = rcPinCache[i];
+			if ((entry.name[length]==0) && (strncmp(entry.name, pin, length)==0)) return entry.pin;
+		}
+	}
+
+	uint8_t p = rcMapPin(pin, length);
+	if ((p!=255) && (cacheable)) {
+		rcPinCacheEntry& entry = rcPinCache[rcPinCacheNext]; //Replace entries round robin
+		memset(entry.name, 0, sizeof(entry.name));
+		memcpy(entry.name, pin, length);
+		entry.pin = p;
+		rcPinCacheNext = (rcPinCacheNext+1) % RC_PIN_CACHE_SIZE;
+	}
+	return p;
+}
+
+uint16_t rcFind(const char* text, uint16_t length, char separator)
+{	//Position of separator in text, or length when not found
+	uint16_t position = 0;
+	for (;position<length;position++) {
+		if (text[position]==separator) break;
+	}
+	return position;
+}
+
 /*bool rcSecurePinMode(const String& pin, uint8_t mode)
 {
 	uint8_t p = rcMapPin(pin);
@@ -66,7 +117,7 @@ uint8_t rcMapPin(String pin)
 
 void rcSecureDigitalWrite(const String& pin, bool state)
 {
-	uint8_t p = rcMapPin(pin);
+	uint8_t p = rcResolvePin(pin.c_str(), pin.length());
 	if (p==255) return;
 
 	digitalWrite(p, state);
@@ -74,7 +125,7 @@ void rcSecureDigitalWrite(const String& pin, bool state)
 
 bool rcSecureDigitalRead(const String& pin)
 {
-	uint8_t p = rcMapPin(pin);
+	uint8_t p = rcResolvePin(pin.c_str(), pin.length());
 	if (p==255) return false;
 
 	return digitalRead(p);
@@ -82,7 +133,7 @@ bool rcSecureDigitalRead(const String& pin)
 
 void rcSecureAnalogWrite(const String& pin, int state)
 {
-	uint8_t p = rcMapPin(pin);
+	uint8_t p = rcResolvePin(pin.c_str(), pin.length());
 	if (p==255) return;
 
 #ifndef ARDUINO_ARCH_ESP32
@@ -94,173 +145,343 @@ void rcSecureAnalogWrite(const String& pin, int state)
 
 int rcSecureAnalogRead(const String& pin)
 {
-	uint8_t p = rcMapPin(pin);
+	uint8_t p = rcResolvePin(pin.c_str(), pin.length());
 	if (p==255) return false;
 
 	return analogRead(p);
 }
 
-void rcTriggerRegister(const String& name, uint8_t pin, bool analog)
+/* Remote triggers */
+rcTrigger rcTriggers[RC_TRIGGER_MAX];
+unsigned long rcAnalogPrevMillis = 0;
+
+//Digital edges, written by the GPIO interrupt and read by rcTriggerRun(). All
+//GPIO interrupts are dispatched by one handler on one core, so there is a
+//single producer and a single consumer and the queue needs no lock.
+struct rcEdge {
+	uint8_t slot;			//Index in rcTriggers
+	uint8_t level;
+	uint32_t us;			//micros() at the interrupt
+};
+
+static_assert((RC_EDGE_QUEUE & (RC_EDGE_QUEUE-1))==0, "RC_EDGE_QUEUE must be a power of two");
+rcEdge rcEdges[RC_EDGE_QUEUE];
+std::atomic<uint16_t> rcEdgeHead(0);	//Next slot the interrupt writes
+std::atomic<uint16_t> rcEdgeTail(0);	//Next slot the loop reads
+std::atomic<uint32_t> rcEdgeOverflows(0);
+HomeyHistogram rcEdgeLatency;			//From the interrupt to the trigger being emitted
+
+#if defined(ARDUINO_ARCH_ESP32)
+	#define RC_TRIGGER_INTERRUPTS
+
+static inline void IRAM_ATTR rcQueueEdge(uint8_t slot, uint8_t level, uint32_t us)
+{
+	uint16_t head = rcEdgeHead.load(std::memory_order_relaxed);
+	if ((uint16_t) (head - rcEdgeTail.load(std::memory_order_acquire)) >= RC_EDGE_QUEUE) {
+		rcEdgeOverflows.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	rcEdge& edge = rcEdges[head & (RC_EDGE_QUEUE-1)];
+	edge.slot = slot;
+	edge.level = level;
+	edge.us = us;
+	rcEdgeHead.store(head+1, std::memory_order_release);
+}
+
+void IRAM_ATTR rcTriggerInterrupt(void* arg)
+{
+	rcTrigger* item = (rcTrigger*) arg;
+	uint8_t level;
+	if (item->pin<32) {
+		level = (REG_READ(GPIO_IN_REG) >> item->pin) & 1;
+	} else {
+		level = (REG_READ(GPIO_IN1_REG) >> (item->pin-32)) & 1;
+	}
+
+	uint8_t slot = item - rcTriggers;
+	uint32_t now = micros();
+	if (level==item->edgeLevel) {
+		//Every interrupt is an edge: a pin that is back at the level of the previous
+		//edge had a pulse shorter than the interrupt latency, report both halves
+		rcQueueEdge(slot, !level, now);
+	}
+	rcQueueEdge(slot, level, now);
+	item->edgeLevel = level;
+}
+#endif
+
+void rcTriggerRegister(const char* name, uint16_t length, uint8_t pin, bool analog)
 {
-	rcTrigger* searchItem = firstRcTrigger;
-	rcTrigger* lastItem = firstRcTrigger;
-
-	while (searchItem) {
-		DEBUG_PRINT("In list ");
-		DEBUG_PRINT(searchItem->name);
-		DEBUG_PRINT(" ");
-		DEBUG_PRINTLN(searchItem->pin);
-		if (searchItem->pin==pin) {
+	rcTrigger* freeItem = NULL;
+	for (uint8_t i = 0; i<RC_TRIGGER_MAX; i++) {
+		rcTrigger& item = rcTriggers[i];
+		if (!item.used) {
+			if (freeItem==NULL) freeItem = &item;
+			continue;
+		}
+		if (item.pin==pin) {
 			DEBUG_PRINTLN("REG ADD EXISTS");
 			return; //Pin already registered, stop
 		}
-		lastItem= searchItem;
-		searchItem = searchItem->next; //Go to next registration
 	}
 
-	rcTrigger* newItem = new rcTrigger;
-	name.toCharArray(newItem->name, 3);
-	newItem->pin = pin;
-	newItem->analog = analog;
-	newItem->prevState = digitalRead(pin);
-	newItem->prev = lastItem;
-	newItem->next = NULL;
-
-	if (lastItem==NULL) {
-		firstRcTrigger = newItem; //First item
-		DEBUG_PRINTLN("REG ADD FIRST");
+	if (freeItem==NULL) {
+		DEBUG_PRINTLN("REG ADD FULL");
+		return;
+	}
+
+	if (length>=sizeof(freeItem->name)) length = sizeof(freeItem->name)-1;
+	memset(freeItem->name, 0, sizeof(freeItem->name));
+	memcpy(freeItem->name, name, length);
+	freeItem->pin = pin;
+	freeItem->analog = analog;
+	freeItem->sum = 0;
+	freeItem->samples = 0;
+	freeItem->lastEmit = millis();
+
+	if (analog) {
+		freeItem->prevState = analogRead(pin);
 	} else {
-		lastItem->next = newItem; //Add to list
-		newItem->prev = lastItem; //Link to list
-		DEBUG_PRINTLN("REG ADD NEXT");
+		freeItem->prevState = digitalRead(pin);
 	}
+	freeItem->edgeLevel = freeItem->prevState;
+	freeItem->used = true;
 
+#if defined(RC_TRIGGER_INTERRUPTS)
+	if (!analog) attachInterruptArg(digitalPinToInterrupt(pin), rcTriggerInterrupt, freeItem, CHANGE);
+#endif
+	DEBUG_PRINTLN("REG ADD OK");
 }
 
-void rcTriggerRemove(uint8_t pin)
+void rcTriggerRegister(const String& name, uint8_t pin, bool analog)
 {
-	rcTrigger* searchItem = firstRcTrigger;
+	rcTriggerRegister(name.c_str(), name.length(), pin, analog);
+}
 
-	while (searchItem) {
-		if (searchItem->pin==pin) {
-			if (searchItem->next) {
-				searchItem->next->prev = searchItem->prev;
-				DEBUG_PRINTLN("Stitch: set n->p");
-			}
-			if (searchItem->prev) {
-				searchItem->prev->next = searchItem->next;
-				DEBUG_PRINTLN("Stitch: set p->n");
-			} else {
-				DEBUG_PRINTLN("Stitch: item has no prev");
-			}
-			if (firstRcTrigger==searchItem) {
-				firstRcTrigger = searchItem->next;
-				DEBUG_PRINTLN("Stitch: item was first");
-			}
-			delete searchItem;
-			DEBUG_PRINTLN("REG DEL OK");
-			return;
-		}
-		searchItem = searchItem->next; //Go to next registration
+void rcTriggerRemove(uint8_t pin)
+{
+	for (uint8_t i = 0; i<RC_TRIGGER_MAX; i++) {
+		rcTrigger& item = rcTriggers[i];
+		if ((!item.used) || (item.pin!=pin)) continue;
+#if defined(RC_TRIGGER_INTERRUPTS)
+		if (!item.analog) detachInterrupt(digitalPinToInterrupt(pin));
+#endif
+		item.used = false; //Edges still queued for this slot are dropped by rcTriggerRun()
+		DEBUG_PRINTLN("REG DEL OK");
+		return;
 	}
 
 	DEBUG_PRINTLN("REG DEL NOT FOUND");
 }
 
-void rcTriggerRun()
+void rcTriggerDigital(rcTrigger& item, uint8_t level)
 {
-	DEBUG_PRINTLN("rcTriggerRun START");
-	rcTrigger* item = firstRcTrigger;
-
-	while (item) {
-		DEBUG_PRINT("rcTriggerRun ITEM");
-		DEBUG_PRINT(item->name);
-		DEBUG_PRINT(" ");
-		uint16_t state;
-		if (item->analog) {
-			state = analogRead(item->pin);
-		} else {
-			state =	digitalRead(item->pin);
-		}
-		DEBUG_PRINT(" = ");
-		DEBUG_PRINTLN(state);
-		if (state!=item->prevState) {
-			item->prevState = state;
-			if (item->analog) {
-				Homey.trigger(String(item->name), (int) state);
-			} else {
-				Homey.trigger(String(item->name), (bool) state);
-			}
-		}
-		item = item->next; //Go to next registration
-	}
-
-	DEBUG_PRINTLN("rcTriggerRun DONE");
+	if (level==item.prevState) return; //Bounce that ended on the reported level
+	item.prevState = level;
+	Homey.trigger(String(item.name), (bool) level);
 }
 
-void rcEndpointMode()
+void rcTriggerRun()
 {
-	uint16_t position = 0;
-	for (;position<Homey.value.length();position++) {
-		if (Homey.value.charAt(position)=='=') break;
+	//Digital pins: report every queued edge, in order
+	uint16_t tail = rcEdgeTail.load(std::memory_order_relaxed);
+	while (tail!=rcEdgeHead.load(std::memory_order_acquire)) {
+		rcEdge edge = rcEdges[tail & (RC_EDGE_QUEUE-1)];
+		rcEdgeTail.store(++tail, std::memory_order_release);
+		rcTrigger& item = rcTriggers[edge.slot];
+		if ((!item.used) || (item.analog)) continue;
+		rcTriggerDigital(item, edge.level);
+		rcEdgeLatency.record(micros() - edge.us);
 	}
 
-	uint8_t mode = 255;
-	bool reg = false;
-	bool trana = false;
-
-	String modeStr = Homey.value.substring(position+1);
+	unsigned long currentMillis = millis();
+	if (currentMillis - rcAnalogPrevMillis < RC_ANALOG_INTERVAL) return;
+	rcAnalogPrevMillis = currentMillis;
+
+	//Sample all analog pins in one pass, report averages that left the deadband
+	for (uint8_t i = 0; i<RC_TRIGGER_MAX; i++) {
+		rcTrigger& item = rcTriggers[i];
+		if (!item.used) continue;
+		if (!item.analog) {
+#if !defined(RC_TRIGGER_INTERRUPTS)
+			rcTriggerDigital(item, digitalRead(item.pin)); //No edge interrupts: poll
+#endif
+			continue;
+		}
 
-	if (modeStr == "di") mode = INPUT;
-	if (modeStr == "dip") mode = INPUT_PULLUP;
-	if (modeStr == "dit") {
-		mode = INPUT;
-		reg = true;
-	}
-	if (modeStr == "ditp") {
-		mode = INPUT_PULLUP;
-		reg = true;
+		item.sum += analogRead(item.pin);
+		if (++item.samples<RC_ANALOG_SAMPLES) continue;
+		uint16_t state = item.sum / item.samples;
+		item.sum = 0;
+		item.samples = 0;
+
+		uint16_t change = (state>item.prevState) ? state-item.prevState : item.prevState-state;
+		if (change<RC_ANALOG_DEADBAND) continue;
+		if (currentMillis - item.lastEmit < RC_ANALOG_MIN_INTERVAL) continue; //Checked again with the next average
+		item.prevState = state;
+		item.lastEmit = currentMillis;
+		Homey.trigger(String(item.name), (int) state);
 	}
-	if (modeStr == "do") mode = OUTPUT;
-	if (modeStr == "ao") mode = OUTPUT;
-	if (modeStr == "ai") mode = INPUT;
-	if (modeStr == "aip") mode = INPUT_PULLUP;
-	if (modeStr == "ait") {
-		mode = INPUT;
-		reg = true;
-		trana = true;
-	}
-	if (modeStr == "aitp") {
-		mode = INPUT_PULLUP;
-		reg = true;
-		trana = true;
+}
+
+void rcTriggerStreamWrite(Stream* s)
+{
+	uint8_t count = 0;
+	for (uint8_t i = 0; i<RC_TRIGGER_MAX; i++) {
+		if (rcTriggers[i].used) count++;
 	}
+	s->print("\"triggers\":");
+	s->print(count);
+	s->print(",\"edgeOverflows\":");
+	s->print(rcEdgeOverflows.load(std::memory_order_relaxed));
+	s->print(",\"edgeLatency\":");
+	rcEdgeLatency.streamWrite(s);
+}
 
-	if (mode==255) return Homey.returnError("invm");
+struct rcModeEntry {
+	const char* name;
+	uint8_t mode;
+	bool reg;			//Register as trigger
+	bool analog;		//Analog trigger
+};
+
+const rcModeEntry rcModes[] = {
+	{ "di",		INPUT,			false,	false },
+	{ "dip",	INPUT_PULLUP,	false,	false },
+	{ "dit",	INPUT,			true,	false },
+	{ "ditp",	INPUT_PULLUP,	true,	false },
+	{ "do",		OUTPUT,			false,	false },
+	{ "ao",		OUTPUT,			false,	false },
+	{ "ai",		INPUT,			false,	false },
+	{ "aip",	INPUT_PULLUP,	false,	false },
+	{ "ait",	INPUT,			true,	true },
+	{ "aitp",	INPUT_PULLUP,	true,	true }
+};
+
+bool rcApplyMode(const char* entry, uint16_t length)
+{	//Applies one "<pin>=<mode>" assignment
+	uint16_t position = rcFind(entry, length, '=');
+	const char* modeStr = entry+position+1;
+	uint16_t modeLength = (position<length) ? length-position-1 : 0;
+
+	const rcModeEntry* mode = NULL;
+	for (uint8_t i = 0; i<sizeof(rcModes)/sizeof(rcModes[0]); i++) {
+		if ((strlen(rcModes[i].name)==modeLength) && (strncmp(rcModes[i].name, modeStr, modeLength)==0)) {
+			mode = &rcModes[i];
+			break;
+		}
+	}
 
-	String name = Homey.value.substring(0,position);
+	if (mode==NULL) { Homey.returnError("invm"); return false; }
 
-	uint8_t pin = rcMapPin(name);
+	uint8_t pin = rcResolvePin(entry, position);
 
-	if (pin==255) return Homey.returnError("invp");
+	if (pin==255) { Homey.returnError("invp"); return false; }
 
-	pinMode(pin, mode);
+	pinMode(pin, mode->mode);
 
-	if (reg) {
-		rcTriggerRegister(name, pin, trana);
+	if (mode->reg) {
+		rcTriggerRegister(entry, position, pin, mode->analog);
 	} else {
 		rcTriggerRemove(pin);
 	}
+	return true;
+}
+
+void rcEndpointMode()
+{
+	rcApplyMode(Homey.value.c_str(), Homey.value.length());
+}
+
+void rcEndpointModeBatch()
+{	//"<pin>=<mode>;<pin>=<mode>;...", stops at the first invalid entry
+	const char* text = Homey.value.c_str();
+	uint16_t length = Homey.value.length();
+	uint16_t start = 0;
+	while (start<length) {
+		uint16_t entryLength = rcFind(text+start, length-start, ';');
+		if (!rcApplyMode(text+start, entryLength)) return;
+		start += entryLength+1;
+	}
 }
 
 void rcEndpointDigitalWrite()
 {
-	uint16_t position = 0;
-	for (;position<Homey.value.length();position++) {
-		if (Homey.value.charAt(position)=='=') break;
+	const char* text = Homey.value.c_str();
+	uint16_t length = Homey.value.length();
+	uint16_t position = rcFind(text, length, '=');
+
+	uint8_t p = rcResolvePin(text, position);
+	if (p==255) return;
+
+	digitalWrite(p, rcParseNumber(text+position+1, (position<length) ? length-position-1 : 0));
+}
+
+void rcEndpointDigitalWriteBatch()
+{	//"<pin>=<0|1>;<pin>=<0|1>;...", all pins change together
+	const char* text = Homey.value.c_str();
+	uint16_t length = Homey.value.length();
+	uint64_t set = 0;
+	uint64_t clear = 0;
+
+	//Resolve everything first, so an invalid entry changes nothing
+	uint16_t start = 0;
+	while (start<length) {
+		uint16_t entryLength = rcFind(text+start, length-start, ';');
+		uint16_t position = rcFind(text+start, entryLength, '=');
+		uint8_t p = rcResolvePin(text+start, position);
+		if (p==255) return;
+		if (p>=64) { Homey.returnError("invdp"); return; }
+		uint16_t valueLength = (position<entryLength) ? entryLength-position-1 : 0;
+		if (rcParseNumber(text+start+position+1, valueLength)) {
+			set |= (uint64_t) 1 << p;
+			clear &= ~((uint64_t) 1 << p);
+		} else {
+			clear |= (uint64_t) 1 << p;
+			set &= ~((uint64_t) 1 << p);
+		}
+		start += entryLength+1;
 	}
 
-	rcSecureDigitalWrite(Homey.value.substring(0,position), Homey.value.substring(position+1).toInt());
+#if defined(ARDUINO_ARCH_ESP32)
+	//One write per output register instead of one digitalWrite per pin
+	if ((uint32_t) set) REG_WRITE(GPIO_OUT_W1TS_REG, (uint32_t) set);
+	if ((uint32_t) clear) REG_WRITE(GPIO_OUT_W1TC_REG, (uint32_t) clear);
+	if (set>>32) REG_WRITE(GPIO_OUT1_W1TS_REG, (uint32_t) (set>>32));
+	if (clear>>32) REG_WRITE(GPIO_OUT1_W1TC_REG, (uint32_t) (clear>>32));
+#else
+	for (uint8_t p = 0; p<64; p++) {
+		if (set & ((uint64_t) 1 << p)) digitalWrite(p, HIGH);
+		if (clear & ((uint64_t) 1 << p)) digitalWrite(p, LOW);
+	}
+#endif
+}
+
+uint64_t rcReadInputs()
+{
+#if defined(ARDUINO_ARCH_ESP32)
+	//GPIO0-31 and GPIO32-39 are each read with a single register access
+	uint32_t low = REG_READ(GPIO_IN_REG);
+	uint32_t high = REG_READ(GPIO_IN1_REG) & 0xFF;
+	return ((uint64_t) high << 32) | low;
+#else
+	uint64_t inputs = 0;
+	for (uint8_t p = 0; (p<NUM_DIGITAL_PINS) && (p<64); p++) {
+		if (digitalRead(p)) inputs |= (uint64_t) 1 << p;
+	}
+	return inputs;
+#endif
+}
+
+void rcEndpointSnapshot()
+{	//Returns the level of every GPIO as a hexadecimal bitmask (bit n = pin n)
+	uint64_t inputs = rcReadInputs();
+	char result[19] = "0x";
+	for (uint8_t i = 0; i<16; i++) {
+		result[2+i] = "0123456789abcdef"[(inputs >> (60-4*i)) & 0xF];
+	}
+	result[18] = 0;
+	Homey.returnResult(result);
 }
 
 void rcEndpointDigitalRead()
@@ -270,12 +491,18 @@ void rcEndpointDigitalRead()
 
 void rcEndpointAnalogWrite()
 {
-	uint16_t position = 0;
-	for (;position<Homey.value.length();position++) {
-		if (Homey.value.charAt(position)=='=') break;
-	}
+	const char* text = Homey.value.c_str();
+	uint16_t length = Homey.value.length();
+	uint16_t position = rcFind(text, length, '=');
 
-	rcSecureAnalogWrite(Homey.value.substring(0,position), Homey.value.substring(position+1).toInt());
+	uint8_t p = rcResolvePin(text, position);
+	if (p==255) return;
+
+#ifndef ARDUINO_ARCH_ESP32
+	analogWrite(p, rcParseNumber(text+position+1, (position<length) ? length-position-1 : 0));
+#else
+	DEBUG_PRINTLN("analog write is not supported on this platform");
+#endif
 }
 
 void rcEndpointAnalogRead()
@@ -286,7 +513,10 @@ void rcEndpointAnalogRead()
 void rcEnable()
 {
 	Homey.addRc("mode", rcEndpointMode);
+	Homey.addRc("mmode", rcEndpointModeBatch);
 	Homey.addRc("dwrite", rcEndpointDigitalWrite);
+	Homey.addRc("mdwrite", rcEndpointDigitalWriteBatch);
+	Homey.addRc("gpio", rcEndpointSnapshot);
 	Homey.addRc("dread", rcEndpointDigitalRead);
 	Homey.addRc("awrite",rcEndpointAnalogWrite);
 	Homey.addRc("aread", rcEndpointAnalogRead);
@@ -3,31 +3,54 @@
 
 	#include "Homey.h"
 
+	#if defined(ARDUINO_ARCH_ESP32)
+		#include "soc/gpio_reg.h"
+		#include "soc/soc.h"
+	#endif
+
 	//Remote pin control functions
+	long rcParseNumber(const char* text, uint16_t length);
+	uint8_t rcMapPin(const char* pin, uint16_t length);
 	uint8_t rcMapPin(String pin);
+	uint8_t rcResolvePin(const char* pin, uint16_t length);	//rcMapPin with a cache of resolved names
+	uint64_t rcReadInputs();								//Levels of all GPIOs (bit n = pin n)
 	//bool rcSecurePinMode(const String& pin, uint8_t state);
 	void rcSecureDigitalWrite(const String& pin, bool state);
 	bool rcSecureDigitalRead(const String& pin);
 	void rcSecureAnalogWrite(const String& pin, int state);
 	int rcSecureAnalogRead(const String& pin);
 
+	//Resolved pin names
+	struct rcPinCacheEntry {
+		char name[4];
+		uint8_t pin;
+	};
+
 	//Remote trigger functions
 	struct rcTrigger {
-		char name[3];
+		char name[4];
 		uint8_t pin;			//Arduino pin number
+		bool used;				//Slot holds a registration
 		bool analog;			//Analog or digital input?
-		uint16_t prevState; //Previous state
-		rcTrigger* prev;	//Linked list (<)
-		rcTrigger* next;	//Linked list (>)
+		uint16_t prevState;		//Last reported state
+		volatile uint8_t edgeLevel;	//Digital: level of the last edge queued by the interrupt
+		uint32_t sum;			//Analog: samples accumulated for the next average
+		uint8_t samples;		//Analog: number of samples in sum
+		unsigned long lastEmit;	//Analog: millis() of the last report
 	};
 
+	void rcTriggerRegister(const char* name, uint16_t length, uint8_t pin, bool analog);	//Name as pointer and length, not terminated
 	void rcTriggerRegister(const String& name, uint8_t pin, bool analog);
 	void rcTriggerRemove(uint8_t pin);
-	void rcTriggerRun();
+	void rcTriggerRun();				//Report queued edges and sample analog pins, call from the loop
+	void rcTriggerStreamWrite(Stream* s);	//Write trigger counters as JSON object members
 
 	//Remote control endpoints
 	void rcEndpointMode();
+	void rcEndpointModeBatch();			//Several "<pin>=<mode>" separated by ';'
 	void rcEndpointDigitalWrite();
+	void rcEndpointDigitalWriteBatch();	//Several "<pin>=<level>" separated by ';'
+	void rcEndpointSnapshot();			//All GPIO levels as a bitmask
 	void rcEndpointDigitalRead();
 	void rcEndpointAnalogWrite();
 	void rcEndpointAnalogRead();
@@ -0,0 +1,240 @@
+#include "Homey.h"
+
+/* HISTOGRAM */
+
+HomeyHistogram::HomeyHistogram()
+{
+	reset();
+}
+
+void HomeyHistogram::record(uint32_t us)
+{
+	uint8_t bucket = 0;
+	uint32_t scaled = us / STATS_BUCKET_BASE_US;
+	while ((scaled>0) && (bucket<STATS_BUCKETS-1)) { scaled >>= 1; bucket++; }
+
+	buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+
+	uint32_t max = maxUs.load(std::memory_order_relaxed);
+	while ((us>max) && (!maxUs.compare_exchange_weak(max, us, std::memory_order_relaxed)));
+}
+
+void HomeyHistogram::reset()
+{
+	count.store(0, std::memory_order_relaxed);
+	maxUs.store(0, std::memory_order_relaxed);
+	for (uint8_t i = 0; i<STATS_BUCKETS; i++) buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void HomeyHistogram::streamWrite(Stream* s)
+{
+	s->print("{\"count\":");
+	s->print(count.load(std::memory_order_relaxed));
+	s->print(",\"maxUs\":");
+	s->print(maxUs.load(std::memory_order_relaxed));
+	s->print(",\"buckets\":[");
+	for (uint8_t i = 0; i<STATS_BUCKETS; i++) {
+		if (i>0) s->print(',');
+		s->print(buckets[i].load(std::memory_order_relaxed));
+	}
+	s->print("]}");
+}
+
+/* ENDPOINT */
+
+HomeyEndpointStats::HomeyEndpointStats()
+{
+	reset();
+}
+
+void HomeyEndpointStats::record(uint16_t code, uint32_t parseUs, uint32_t callbackUs, uint32_t writeUs)
+{
+	uint8_t slot;
+	switch (code) {
+		case 200: slot = STATS_STATUS_200; break;
+		case 400: slot = STATS_STATUS_400; break;
+		case 404: slot = STATS_STATUS_404; break;
+		case 500: slot = STATS_STATUS_500; break;
+		case 501: slot = STATS_STATUS_501; break;
+		case 0: slot = STATS_STATUS_ABORTED; break;
+		default: slot = STATS_STATUS_OTHER; break;
+	}
+	requests.fetch_add(1, std::memory_order_relaxed);
+	status[slot].fetch_add(1, std::memory_order_relaxed);
+	parse.record(parseUs);
+	callback.record(callbackUs);
+	if (slot!=STATS_STATUS_ABORTED) write.record(writeUs);
+}
+
+void HomeyEndpointStats::reset()
+{
+	requests.store(0, std::memory_order_relaxed);
+	for (uint8_t i = 0; i<STATS_STATUS_SLOTS; i++) status[i].store(0, std::memory_order_relaxed);
+	parse.reset();
+	callback.reset();
+	write.reset();
+}
+
+void HomeyEndpointStats::streamWrite(Stream* s)
+{
+	s->print("\"requests\":");
+	s->print(requests.load(std::memory_order_relaxed));
+	s->print(",\"status\":{\"200\":");
+	s->print(status[STATS_STATUS_200].load(std::memory_order_relaxed));
+	s->print(",\"400\":");
+	s->print(status[STATS_STATUS_400].load(std::memory_order_relaxed));
+	s->print(",\"404\":");
+	s->print(status[STATS_STATUS_404].load(std::memory_order_relaxed));
+	s->print(",\"500\":");
+	s->print(status[STATS_STATUS_500].load(std::memory_order_relaxed));
+	s->print(",\"501\":");
+	s->print(status[STATS_STATUS_501].load(std::memory_order_relaxed));
+	s->print(",\"aborted\":");
+	s->print(status[STATS_STATUS_ABORTED].load(std::memory_order_relaxed));
+	s->print(",\"other\":");
+	s->print(status[STATS_STATUS_OTHER].load(std::memory_order_relaxed));
+	s->print("},\"parse\":");
+	parse.streamWrite(s);
+	s->print(",\"callback\":");
+	callback.streamWrite(s);
+	s->print(",\"write\":");
+	write.streamWrite(s);
+}
+
+/* EMIT */
+
+HomeyEmitStats::HomeyEmitStats()
+{
+	reset();
+}
+
+void HomeyEmitStats::record(uint8_t result, uint32_t bytes, uint32_t connectUs, uint32_t firstByteUs, uint32_t totalUs)
+{
+	emits.fetch_add(1, std::memory_order_relaxed);
+	results[result].fetch_add(1, std::memory_order_relaxed);
+	bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+	if (connectUs>0) connect.record(connectUs);
+	if (firstByteUs>0) firstByte.record(firstByteUs);
+	total.record(totalUs);
+}
+
+void HomeyEmitStats::reset()
+{
+	emits.store(0, std::memory_order_relaxed);
+	for (uint8_t i = 0; i<STATS_EMIT_RESULTS; i++) results[i].store(0, std::memory_order_relaxed);
+	bytesSent.store(0, std::memory_order_relaxed);
+	connect.reset();
+	firstByte.reset();
+	total.reset();
+}
+
+void HomeyEmitStats::streamWrite(Stream* s)
+{
+	s->print("\"emits\":");
+	s->print(emits.load(std::memory_order_relaxed));
+	s->print(",\"bytesSent\":");
+	s->print(bytesSent.load(std::memory_order_relaxed));
+	s->print(",\"results\":{\"ok\":");
+	s->print(results[STATS_EMIT_OK].load(std::memory_order_relaxed));
+	s->print(",\"noMaster\":");
+	s->print(results[STATS_EMIT_NO_MASTER].load(std::memory_order_relaxed));
+	s->print(",\"connect\":");
+	s->print(results[STATS_EMIT_CONNECT].load(std::memory_order_relaxed));
+	s->print(",\"timeout\":");
+	s->print(results[STATS_EMIT_TIMEOUT].load(std::memory_order_relaxed));
+	s->print(",\"rejected\":");
+	s->print(results[STATS_EMIT_REJECTED].load(std::memory_order_relaxed));
+	s->print("},\"connect\":");
+	connect.streamWrite(s);
+	s->print(",\"firstByte\":");
+	firstByte.streamWrite(s);
+	s->print(",\"total\":");
+	total.streamWrite(s);
+}
+
+HomeyEmitTable::HomeyEmitTable()
+{
+	reset();
+}
+
+HomeyEmitStats& HomeyEmitTable::event(const void* device, const char* type, const char* name)
+{
+	HomeyEmitEvent* freeSlot = NULL;
+	for (uint8_t i = 0; i<STATS_EMIT_EVENTS; i++) {
+		HomeyEmitEvent& slot = events[i];
+		if (slot.device==NULL) {
+			if (freeSlot==NULL) freeSlot = &slot;
+			continue;
+		}
+		if ((slot.device==device) &&
+			(strncmp(slot.type, type, MAX_TYPE_LENGTH-1)==0) &&
+			(strncmp(slot.name, name, MAX_NAME_LENGTH-1)==0)) {
+			return slot.stats;
+		}
+	}
+	if (freeSlot==NULL) return otherEvents;
+
+	//The event has not been seen before
+	freeSlot->device = device;
+	strncpy(freeSlot->type, type, MAX_TYPE_LENGTH-1);
+	strncpy(freeSlot->name, name, MAX_NAME_LENGTH-1);
+	return freeSlot->stats;
+}
+
+void HomeyEmitTable::forget(const void* device)
+{
+	for (uint8_t i = 0; i<STATS_EMIT_EVENTS; i++) {
+		if (events[i].device!=device) continue;
+		events[i].device = NULL;
+		memset(events[i].type, 0, MAX_TYPE_LENGTH);
+		memset(events[i].name, 0, MAX_NAME_LENGTH);
+		events[i].stats.reset();
+	}
+}
+
+HomeyEmitStats& HomeyEmitTable::master(const IPAddress& host, uint16_t port)
+{
+	for (uint8_t i = 0; i<STATS_EMIT_MASTERS; i++) {
+		HomeyEmitMaster& slot = masters[i];
+		if (!slot.used) {
+			slot.used = true;
+			slot.host = host;
+			slot.port = port;
+			return slot.stats;
+		}
+		if ((slot.host==host) && (slot.port==port)) return slot.stats;
+	}
+	return otherMasters;
+}
+
+void HomeyEmitTable::reset()
+{
+	for (uint8_t i = 0; i<STATS_EMIT_EVENTS; i++) {
+		events[i].device = NULL;
+		memset(events[i].type, 0, MAX_TYPE_LENGTH);
+		memset(events[i].name, 0, MAX_NAME_LENGTH);
+		events[i].stats.reset();
+	}
+	for (uint8_t i = 0; i<STATS_EMIT_MASTERS; i++) {
+		masters[i].used = false;
+		masters[i].stats.reset();
+	}
+	otherEvents.reset();
+	otherMasters.reset();
+	all.reset();
+}
+
+/* SERVER */
+
+HomeyServerStats::HomeyServerStats()
+{
+	reset();
+}
+
+void HomeyServerStats::reset()
+{
+	parseErrors.store(0, std::memory_order_relaxed);
+	discoveries.store(0, std::memory_order_relaxed);
+	other.reset();
+}
@@ -0,0 +1,117 @@
+#ifndef __HOMEY_STATS__
+	#define __HOMEY_STATS__
+
+	#include "Homey.h"
+	#include <atomic>
+
+	//Latency histograms use power-of-two buckets: bucket 0 counts everything below
+	//STATS_BUCKET_BASE_US, bucket n counts [BASE << (n-1), BASE << n), and the last
+	//bucket is open ended.
+	#define STATS_BUCKET_BASE_US	32
+	#define STATS_BUCKETS			16
+
+	//Status code slots of HomeyEndpointStats::status
+	#define STATS_STATUS_200		0
+	#define STATS_STATUS_400		1
+	#define STATS_STATUS_404		2
+	#define STATS_STATUS_500		3
+	#define STATS_STATUS_501		4
+	#define STATS_STATUS_ABORTED	5	//Client went away before a response was written (code 0)
+	#define STATS_STATUS_OTHER		6	//Any other status code
+	#define STATS_STATUS_SLOTS		7
+
+	//Outcome slots of HomeyEmitStats::results
+	#define STATS_EMIT_OK			0	//Delivered (HTTP response received or datagram queued)
+	#define STATS_EMIT_NO_MASTER	1	//No master configured for the device
+	#define STATS_EMIT_CONNECT		2	//Could not connect to the master
+	#define STATS_EMIT_TIMEOUT		3	//Request sent, but no response before the timeout
+	#define STATS_EMIT_REJECTED		4	//Datagram transport did not accept the event
+	#define STATS_EMIT_RESULTS		5
+
+	//Fixed capacity of the emit tables; events beyond this are counted in "other"
+	#define STATS_EMIT_EVENTS		12
+	#define STATS_EMIT_MASTERS		2
+
+	//All counters are relaxed 32-bit atomics, which are lock-free on the ESP32:
+	//recording never takes a lock and readers may see a histogram that is one
+	//sample ahead of its count.
+	struct HomeyHistogram {
+		std::atomic<uint32_t> count;
+		std::atomic<uint32_t> maxUs;
+		std::atomic<uint32_t> buckets[STATS_BUCKETS];
+
+		HomeyHistogram();
+		void record(uint32_t us);												//Add one sample
+		void reset();															//Clear all samples
+		void streamWrite(Stream* s);											//Write as a JSON object
+	};
+
+	struct HomeyEndpointStats {
+		std::atomic<uint32_t> requests;
+		std::atomic<uint32_t> status[STATS_STATUS_SLOTS];
+		HomeyHistogram parse;													//Reading and parsing the HTTP request
+		HomeyHistogram callback;												//Running the endpoint callback
+		HomeyHistogram write;													//Writing the HTTP response
+
+		HomeyEndpointStats();
+		void record(uint16_t code, uint32_t parseUs, uint32_t callbackUs,		//Account one request
+				uint32_t writeUs);
+		void reset();															//Clear all counters
+		void streamWrite(Stream* s);											//Write the counters as JSON object members
+	};
+
+	struct HomeyEmitStats {
+		std::atomic<uint32_t> emits;
+		std::atomic<uint32_t> results[STATS_EMIT_RESULTS];
+		std::atomic<uint32_t> bytesSent;
+		HomeyHistogram connect;													//Opening the connection to the master
+		HomeyHistogram firstByte;												//From the end of the request to the first response byte
+		HomeyHistogram total;													//The whole emit, from call to return
+
+		HomeyEmitStats();
+		void record(uint8_t result, uint32_t bytes, uint32_t connectUs,			//Account one emit (connect/firstByte are skipped when 0)
+				uint32_t firstByteUs, uint32_t totalUs);
+		void reset();															//Clear all counters
+		void streamWrite(Stream* s);											//Write the counters as JSON object members
+	};
+
+	struct HomeyEmitEvent {
+		const void* device;														//Device that emitted the event (NULL: slot is free)
+		char type[MAX_TYPE_LENGTH];
+		char name[MAX_NAME_LENGTH];
+		HomeyEmitStats stats;
+	};
+
+	struct HomeyEmitMaster {
+		bool used;
+		IPAddress host;
+		uint16_t port;
+		HomeyEmitStats stats;
+	};
+
+	//Slots are claimed by the task that emits (the Arduino loop), the counters
+	//themselves may be read from anywhere.
+	struct HomeyEmitTable {
+		HomeyEmitEvent events[STATS_EMIT_EVENTS];
+		HomeyEmitMaster masters[STATS_EMIT_MASTERS];
+		HomeyEmitStats otherEvents;												//Events that did not fit in the table
+		HomeyEmitStats otherMasters;											//Masters that did not fit in the table
+		HomeyEmitStats all;														//Totals over every emit
+
+		HomeyEmitTable();
+		HomeyEmitStats& event(const void* device, const char* type,				//Find or claim the slot of an event
+				const char* name);
+		HomeyEmitStats& master(const IPAddress& host, uint16_t port);			//Find or claim the slot of a master
+		void forget(const void* device);										//Free the event slots of a removed device
+		void reset();															//Clear all counters and free all slots
+	};
+
+	struct HomeyServerStats {
+		std::atomic<uint32_t> parseErrors;										//Requests that could not be parsed
+		std::atomic<uint32_t> discoveries;										//Discovery packets answered
+		HomeyEndpointStats other;												//Requests not handled by an endpoint (index, system, not found)
+
+		HomeyServerStats();
+		void reset();
+	};
+#endif
@@ -4,7 +4,9 @@
 #ifndef __CHIP__
 	#define __CHIP__
 
-	#if defined(ARDUINO_ARCH_ESP8266) //ESP8266
+	#if defined(HOMEY_USE_POSIX) //Linux process
+		static const char* arduino_arch = "posix";
+	#elif defined(ARDUINO_ARCH_ESP8266) //ESP8266
 		static const char* arduino_arch = "esp8266";
 	#elif defined(ARDUINO_ARCH_ESP32) //ESP32
 		static const char* arduino_arch = "esp32";
@@ -0,0 +1,256 @@
+#if defined(HOMEY_USE_POSIX)
+
+#include "Arduino.h"
+
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <arpa/inet.h>
+
+/* STRING */
+
+String::String() {}
+String::String(const char* value) : _value(value ? value : "") {}
+String::String(const std::string& value) : _value(value) {}
+String::String(char value) : _value(1, value) {}
+
+static std::string formatInteger(unsigned long long value, bool negative, unsigned char base)
+{
+	char buffer[66];
+	char* p = buffer + sizeof(buffer) - 1;
+	*p = 0;
+	do {
+		*--p = "0123456789abcdef"[value % base];
+		value /= base;
+	} while (value>0);
+	if (negative) *--p = '-';
+	return std::string(p);
+}
+
+String::String(unsigned char value, unsigned char base) : _value(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base) : String((long) value, base) {}
+String::String(unsigned int value, unsigned char base) : _value(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base)
+: _value((value<0) && (base==DEC) ? formatInteger(-(unsigned long long) value, true, base) : formatInteger((unsigned long) value, false, base)) {}
+String::String(unsigned long value, unsigned char base) : _value(formatInteger(value, false, base)) {}
+String::String(float value, unsigned char decimals) : String((double) value, decimals) {}
+
+String::String(double value, unsigned char decimals)
+{
+	char buffer[64];
+	snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+	_value = buffer;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+	size_t position = _value.find(c, from);
+	return (position==std::string::npos) ? -1 : (int) position;
+}
+
+String String::substring(unsigned int from) const
+{
+	return substring(from, _value.length());
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+	if (from>to) { unsigned int t = from; from = to; to = t; }
+	if (from>=_value.length()) return String();
+	if (to>_value.length()) to = _value.length();
+	return String(_value.substr(from, to-from));
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+	if (index<_value.length()) _value.erase(index, count);
+}
+
+void String::trim()
+{
+	size_t first = _value.find_first_not_of(" \t\r\n");
+	if (first==std::string::npos) { _value.clear(); return; }
+	size_t last = _value.find_last_not_of(" \t\r\n");
+	_value = _value.substr(first, last-first+1);
+}
+
+void String::toCharArray(char* buffer, unsigned int size) const
+{
+	if (size<1) return;
+	strncpy(buffer, _value.c_str(), size-1);
+	buffer[size-1] = 0;
+}
+
+String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+String operator+(const String& a, char b) { String r(a); r += b; return r; }
+
+/* PRINT */
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+	size_t n = 0;
+	while (size--) {
+		if (write(*buffer++)==0) break;
+		n++;
+	}
+	return n;
+}
+
+size_t Print::print(long value, int base) { return print(String(value, base)); }
+size_t Print::print(unsigned long value, int base) { return print(String(value, base)); }
+size_t Print::print(long long value, int base) { return print(String((long) value, base)); }
+size_t Print::print(unsigned long long value, int base) { return print(String((unsigned long) value, base)); }
+size_t Print::print(double value, int decimals) { return print(String(value, decimals)); }
+
+HostSerial Serial;
+
+size_t HostSerial::write(uint8_t c)
+{
+	return (fputc(c, stdout)==EOF) ? 0 : 1;
+}
+
+size_t HostSerial::write(const uint8_t* buffer, size_t size)
+{
+	return fwrite(buffer, 1, size, stdout);
+}
+
+void HostSerial::flush()
+{
+	fflush(stdout);
+}
+
+/* IP ADDRESS */
+
+IPAddress::IPAddress()
+{
+	memset(_bytes, 0, sizeof(_bytes));
+}
+
+IPAddress::IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+{
+	_bytes[0] = a;
+	_bytes[1] = b;
+	_bytes[2] = c;
+	_bytes[3] = d;
+}
+
+IPAddress::IPAddress(uint32_t address)
+{
+	memcpy(_bytes, &address, sizeof(_bytes));
+}
+
+IPAddress::operator uint32_t() const
+{
+	uint32_t address;
+	memcpy(&address, _bytes, sizeof(address));
+	return address;
+}
+
+bool IPAddress::fromString(const char* address)
+{
+	struct in_addr parsed;
+	if (inet_pton(AF_INET, address, &parsed)!=1) return false;
+	memcpy(_bytes, &parsed.s_addr, sizeof(_bytes));
+	return true;
+}
+
+String IPAddress::toString() const
+{
+	char buffer[16];
+	snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+	return String(buffer);
+}
+
+size_t IPAddress::printTo(Print& p) const
+{
+	return p.print(toString());
+}
+
+/* TIME AND RANDOM */
+
+static uint64_t monotonicUs()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t) now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
+
+static const uint64_t startUs = monotonicUs();
+
+unsigned long millis()
+{
+	return (monotonicUs() - startUs) / 1000;
+}
+
+unsigned long micros()
+{
+	return (unsigned long) (monotonicUs() - startUs);
+}
+
+void delay(unsigned long ms)
+{
+	usleep(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+	usleep(us);
+}
+
+void yield()
+{
+	sched_yield();
+}
+
+long random(long max)
+{
+	return (max<=0) ? 0 : ::random() % max;
+}
+
+long random(long min, long max)
+{
+	return (max<=min) ? min : min + random(max - min);
+}
+
+void randomSeed(unsigned long seed)
+{
+	srandom(seed);
+}
+
+/* PINS */
+
+static int hostPins[NUM_DIGITAL_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+	if ((pin<NUM_DIGITAL_PINS) && (mode==INPUT_PULLUP)) hostPins[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+	if (pin<NUM_DIGITAL_PINS) hostPins[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin)
+{
+	return (pin<NUM_DIGITAL_PINS) ? (hostPins[pin] ? HIGH : LOW) : LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+	return (pin<NUM_DIGITAL_PINS) ? hostPins[pin] : 0;
+}
+
+void analogWrite(uint8_t pin, int value)
+{
+	if (pin<NUM_DIGITAL_PINS) hostPins[pin] = value;
+}
+
+void hostSetPin(uint8_t pin, int value)
+{
+	if (pin<NUM_DIGITAL_PINS) hostPins[pin] = value;
+}
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef __HOMEY_POSIX_ARDUINO__
+	#define __HOMEY_POSIX_ARDUINO__
+
+	//Minimal Arduino core for building the Homey library as a Linux process
+	//(HOMEY_USE_POSIX). Only what the library and the host tools use is provided;
+	//pins are simulated in memory so the remote configuration endpoints work.
+
+	#include <stdint.h>
+	#include <stddef.h>
+	#include <stdlib.h>
+	#include <stdio.h>
+	#include <string.h>
+	#include <ctype.h>
+	#include <math.h>
+	#include <string>
+
+	#include "pins_arduino.h"
+
+	typedef uint8_t byte;
+	typedef bool boolean;
+
+	#define HIGH			1
+	#define LOW				0
+	#define INPUT			0x01
+	#define OUTPUT			0x03
+	#define INPUT_PULLUP	0x05
+	#define RISING			0x01
+	#define FALLING			0x02
+	#define CHANGE			0x03
+
+	#define DEC				10
+	#define HEX				16
+
+	#define IRAM_ATTR
+
+	#define isDigit(c)		(isdigit((unsigned char) (c))!=0)
+
+	/* STRING */
+
+	class String {
+		public:
+			String();
+			String(const char* value);
+			String(const std::string& value);
+			explicit String(char value);
+			explicit String(unsigned char value, unsigned char base=DEC);
+			explicit String(int value, unsigned char base=DEC);
+			explicit String(unsigned int value, unsigned char base=DEC);
+			explicit String(long value, unsigned char base=DEC);
+			explicit String(unsigned long value, unsigned char base=DEC);
+			explicit String(float value, unsigned char decimals=2);
+			explicit String(double value, unsigned char decimals=2);
+
+			const char* c_str() const { return _value.c_str(); }
+			unsigned int length() const { return _value.length(); }
+			void reserve(unsigned int size) { _value.reserve(size); }
+
+			String& operator=(char value) { _value.assign(1, value); return *this; }
+			String& operator+=(const String& other) { _value += other._value; return *this; }
+			String& operator+=(const char* other) { if (other) _value += other; return *this; }
+			String& operator+=(char other) { _value += other; return *this; }
+			bool concat(const String& other) { _value += other._value; return true; }
+
+			bool operator==(const String& other) const { return _value==other._value; }
+			bool operator==(const char* other) const { return _value==(other ? other : ""); }
+			bool operator!=(const String& other) const { return _value!=other._value; }
+			bool operator!=(const char* other) const { return !(*this==other); }
+			bool operator<(const String& other) const { return _value<other._value; }
+			bool equals(const String& other) const { return _value==other._value; }
+			bool equals(const char* other) const { return *this==other; }
+			bool startsWith(const String& prefix) const { return _value.compare(0, prefix.length(), prefix._value)==0; }
+
+			char charAt(unsigned int index) const { return (index<_value.length()) ? _value[index] : 0; }
+			char operator[](unsigned int index) const { return charAt(index); }
+			int indexOf(char c, unsigned int from=0) const;
+			String substring(unsigned int from) const;
+			String substring(unsigned int from, unsigned int to) const;
+			void remove(unsigned int index, unsigned int count=(unsigned int) -1);
+			void trim();
+			void toCharArray(char* buffer, unsigned int size) const;
+
+			long toInt() const { return atol(_value.c_str()); }
+			float toFloat() const { return atof(_value.c_str()); }
+
+		private:
+			std::string _value;
+	};
+
+	String operator+(const String& a, const String& b);
+	String operator+(const String& a, const char* b);
+	String operator+(const char* a, const String& b);
+	String operator+(const String& a, char b);
+
+	/* PRINT AND STREAM */
+
+	class Print;
+
+	class Printable {
+		public:
+			virtual ~Printable() {}
+			virtual size_t printTo(Print& p) const = 0;
+	};
+
+	class Print {
+		public:
+			virtual ~Print() {}
+			virtual size_t write(uint8_t c) = 0;
+			virtual size_t write(const uint8_t* buffer, size_t size);
+			size_t write(const char* str) { return (str==NULL) ? 0 : write((const uint8_t*) str, strlen(str)); }
+			size_t write(const char* buffer, size_t size) { return write((const uint8_t*) buffer, size); }
+
+			size_t print(const String& value) { return write(value.c_str(), value.length()); }
+			size_t print(const char* value) { return write(value); }
+			size_t print(char value) { return write((uint8_t) value); }
+			size_t print(unsigned char value, int base=DEC) { return print((unsigned long) value, base); }
+			size_t print(int value, int base=DEC) { return print((long) value, base); }
+			size_t print(unsigned int value, int base=DEC) { return print((unsigned long) value, base); }
+			size_t print(long value, int base=DEC);
+			size_t print(unsigned long value, int base=DEC);
+			size_t print(long long value, int base=DEC);
+			size_t print(unsigned long long value, int base=DEC);
+			size_t print(double value, int decimals=2);
+			size_t print(const Printable& value) { return value.printTo(*this); }
+
+			size_t println() { return write("\r\n"); }
+			template<typename T> size_t println(const T& value) { size_t n = print(value); return n + println(); }
+			template<typename T> size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+			virtual void flush() {}
+	};
+
+	class Stream : public Print {
+		public:
+			Stream() : _timeout(1000) {}
+			virtual int available() = 0;
+			virtual int read() = 0;
+			virtual int peek() = 0;
+			void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+		protected:
+			unsigned long _timeout;
+	};
+
+	//Serial writes to stdout and never has input
+	class HostSerial : public Stream {
+		public:
+			using Print::write;
+			void begin(unsigned long) {}
+			size_t write(uint8_t c);
+			size_t write(const uint8_t* buffer, size_t size);
+			int available() { return 0; }
+			int read() { return -1; }
+			int peek() { return -1; }
+			void flush();
+			operator bool() const { return true; }
+	};
+
+	extern HostSerial Serial;
+
+	/* IP ADDRESS */
+
+	class IPAddress : public Printable {
+		public:
+			IPAddress();
+			IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d);
+			IPAddress(uint32_t address);									//In network byte order, as stored in sockaddr_in
+
+			operator uint32_t() const;
+			bool operator==(const IPAddress& other) const { return (uint32_t) *this==(uint32_t) other; }
+			bool operator!=(const IPAddress& other) const { return !(*this==other); }
+			uint8_t operator[](int index) const { return _bytes[index]; }
+			uint8_t& operator[](int index) { return _bytes[index]; }
+
+			bool fromString(const char* address);
+			bool fromString(const String& address) { return fromString(address.c_str()); }
+			String toString() const;
+			size_t printTo(Print& p) const;
+
+		private:
+			uint8_t _bytes[4];
+	};
+
+	/* TIME, RANDOM AND PINS */
+
+	unsigned long millis();
+	unsigned long micros();
+	void delay(unsigned long ms);
+	void delayMicroseconds(unsigned int us);
+	void yield();
+
+	long random(long max);
+	long random(long min, long max);
+	void randomSeed(unsigned long seed);
+
+	void pinMode(uint8_t pin, uint8_t mode);
+	void digitalWrite(uint8_t pin, uint8_t value);
+	int digitalRead(uint8_t pin);
+	int analogRead(uint8_t pin);
+	void analogWrite(uint8_t pin, int value);
+	void hostSetPin(uint8_t pin, int value);								//Simulate an input level (digital or analog)
+#endif
@@ -0,0 +1,350 @@
+#if defined(HOMEY_USE_POSIX)
+
+#include "HomeyPosix.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+static void setNonBlocking(int fd)
+{
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+static void toSockaddr(const IPAddress& ip, uint16_t port, struct sockaddr_in& address)
+{
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = (uint32_t) ip;
+}
+
+/* TCP CLIENT */
+
+PosixClient::PosixClient()
+: _fd(-1), _rxStart(0), _rxEnd(0), _txLength(0)
+{
+}
+
+PosixClient::PosixClient(int fd)
+: _fd(fd), _rxStart(0), _rxEnd(0), _txLength(0)
+{
+	if (_fd<0) return;
+	int one = 1;
+	setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	setNonBlocking(_fd);
+}
+
+PosixClient::PosixClient(PosixClient&& other)
+: _fd(-1), _rxStart(0), _rxEnd(0), _txLength(0)
+{
+	*this = static_cast<PosixClient&&>(other);
+}
+
+PosixClient& PosixClient::operator=(PosixClient&& other)
+{
+	if (this==&other) return *this;
+	stop();
+	_fd = other._fd;
+	_rxStart = other._rxStart;
+	_rxEnd = other._rxEnd;
+	_txLength = other._txLength;
+	memcpy(_rx, other._rx, _rxEnd);
+	memcpy(_tx, other._tx, _txLength);
+	other._fd = -1;
+	other._rxStart = other._rxEnd = other._txLength = 0;
+	return *this;
+}
+
+PosixClient::~PosixClient()
+{
+	stop();
+}
+
+int PosixClient::connect(const IPAddress& ip, uint16_t port)
+{
+	stop();
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd<0) return 0;
+	setNonBlocking(fd);
+
+	struct sockaddr_in address;
+	toSockaddr(ip, port, address);
+	if ((::connect(fd, (struct sockaddr*) &address, sizeof(address))<0) && (errno!=EINPROGRESS)) {
+		close(fd);
+		return 0;
+	}
+
+	//Wait for the handshake, like the blocking connect() of the WiFi client
+	struct pollfd p = { fd, POLLOUT, 0 };
+	int error = 0;
+	socklen_t length = sizeof(error);
+	if ((poll(&p, 1, POSIX_CONNECT_TIMEOUT)!=1) ||
+		(getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length)<0) || (error!=0)) {
+		close(fd);
+		return 0;
+	}
+
+	*this = PosixClient(fd);
+	return 1;
+}
+
+uint8_t PosixClient::connected()
+{
+	if (_fd<0) return 0;
+	if (_rxStart<_rxEnd) return 1;
+	return fill() ? 1 : 0;
+}
+
+void PosixClient::stop()
+{
+	if (_fd<0) return;
+	flush();
+	close(_fd);
+	_fd = -1;
+	_rxStart = _rxEnd = _txLength = 0;
+}
+
+size_t PosixClient::write(uint8_t c)
+{
+	return write(&c, 1);
+}
+
+size_t PosixClient::write(const uint8_t* buffer, size_t size)
+{
+	if (_fd<0) return 0;
+	size_t written = 0;
+	while (written<size) {
+		if (_txLength==POSIX_TX_BUFFER) {
+			flush();
+			if (_fd<0) break;
+		}
+		size_t chunk = size - written;
+		if (chunk>(size_t) (POSIX_TX_BUFFER - _txLength)) chunk = POSIX_TX_BUFFER - _txLength;
+		memcpy(_tx + _txLength, buffer + written, chunk);
+		_txLength += chunk;
+		written += chunk;
+	}
+	return written;
+}
+
+void PosixClient::flush()
+{
+	uint16_t sent = 0;
+	while ((_fd>=0) && (sent<_txLength)) {
+		ssize_t n = send(_fd, _tx + sent, _txLength - sent, MSG_NOSIGNAL);
+		if (n>0) { sent += n; continue; }
+		if ((n<0) && ((errno==EAGAIN) || (errno==EWOULDBLOCK) || (errno==EINTR))) {
+			struct pollfd p = { _fd, POLLOUT, 0 };
+			poll(&p, 1, 10);
+			continue;
+		}
+		break; //Peer went away, the rest is lost as it would be on the device
+	}
+	_txLength = 0;
+}
+
+bool PosixClient::fill()
+{
+	if (_rxStart==_rxEnd) _rxStart = _rxEnd = 0;
+	if (_rxEnd==POSIX_RX_BUFFER) return true;
+	ssize_t n = recv(_fd, _rx + _rxEnd, POSIX_RX_BUFFER - _rxEnd, MSG_DONTWAIT);
+	if (n>0) { _rxEnd += n; return true; }
+	if (n==0) return false;
+	return (errno==EAGAIN) || (errno==EWOULDBLOCK) || (errno==EINTR);
+}
+
+int PosixClient::available()
+{
+	if (_fd<0) return 0;
+	flush(); //A request must be on the wire before its response can arrive
+	if (_rxStart==_rxEnd) fill();
+	return _rxEnd - _rxStart;
+}
+
+int PosixClient::read()
+{
+	if (!available()) return -1;
+	return _rx[_rxStart++];
+}
+
+int PosixClient::read(uint8_t* buffer, size_t size)
+{
+	size_t count = available();
+	if (count>size) count = size;
+	memcpy(buffer, _rx + _rxStart, count);
+	_rxStart += count;
+	return count;
+}
+
+int PosixClient::peek()
+{
+	if (!available()) return -1;
+	return _rx[_rxStart];
+}
+
+/* TCP SERVER */
+
+PosixServer::PosixServer(uint16_t port)
+: _address(0,0,0,0), _port(port), _fd(-1)
+{
+}
+
+PosixServer::~PosixServer()
+{
+	stop();
+}
+
+void PosixServer::begin()
+{
+	if (_fd>=0) return;
+	_fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (_fd<0) return;
+	int one = 1;
+	setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+	struct sockaddr_in address;
+	toSockaddr(_address, _port, address);
+	if ((bind(_fd, (struct sockaddr*) &address, sizeof(address))<0) || (listen(_fd, SOMAXCONN)<0)) {
+		perror("homey: tcp server");
+		close(_fd);
+		_fd = -1;
+		return;
+	}
+	setNonBlocking(_fd);
+}
+
+void PosixServer::stop()
+{
+	if (_fd<0) return;
+	close(_fd);
+	_fd = -1;
+}
+
+PosixClient PosixServer::available()
+{
+	if (_fd<0) return PosixClient();
+	return PosixClient(accept(_fd, NULL, NULL));
+}
+
+/* UDP */
+
+PosixUDP::PosixUDP()
+: _fd(-1), _rxPosition(0), _rxLength(0), _remotePort(0), _txLength(0), _txPort(0)
+{
+}
+
+PosixUDP::~PosixUDP()
+{
+	stop();
+}
+
+uint8_t PosixUDP::begin(uint16_t port)
+{
+	return begin(IPAddress(0,0,0,0), port);
+}
+
+uint8_t PosixUDP::begin(const IPAddress& localAddress, uint16_t port)
+{
+	stop();
+	_fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (_fd<0) return 0;
+	int one = 1;
+	setsockopt(_fd, SOL_SOCKET, SO_BROADCAST, &one, sizeof(one)); //No SO_REUSEADDR: sockets sharing a port steal each other's unicasts
+
+	struct sockaddr_in address;
+	toSockaddr(localAddress, port, address);
+	if (bind(_fd, (struct sockaddr*) &address, sizeof(address))<0) {
+		perror("homey: udp");
+		close(_fd);
+		_fd = -1;
+		return 0;
+	}
+	setNonBlocking(_fd);
+	return 1;
+}
+
+void PosixUDP::stop()
+{
+	if (_fd<0) return;
+	close(_fd);
+	_fd = -1;
+	_rxPosition = _rxLength = _txLength = 0;
+}
+
+int PosixUDP::parsePacket()
+{
+	_rxPosition = _rxLength = 0;
+	if (_fd<0) return 0;
+	struct sockaddr_in address;
+	socklen_t length = sizeof(address);
+	ssize_t n = recvfrom(_fd, _rx, sizeof(_rx), MSG_DONTWAIT, (struct sockaddr*) &address, &length);
+	if (n<=0) return 0;
+	_rxLength = n;
+	_remoteIP = IPAddress((uint32_t) address.sin_addr.s_addr);
+	_remotePort = ntohs(address.sin_port);
+	return n;
+}
+
+int PosixUDP::available()
+{
+	return _rxLength - _rxPosition;
+}
+
+int PosixUDP::read()
+{
+	if (_rxPosition>=_rxLength) return -1;
+	return _rx[_rxPosition++];
+}
+
+int PosixUDP::read(uint8_t* buffer, size_t size)
+{
+	size_t count = available();
+	if (count>size) count = size;
+	memcpy(buffer, _rx + _rxPosition, count);
+	_rxPosition += count;
+	return count;
+}
+
+int PosixUDP::peek()
+{
+	if (_rxPosition>=_rxLength) return -1;
+	return _rx[_rxPosition];
+}
+
+int PosixUDP::beginPacket(const IPAddress& ip, uint16_t port)
+{
+	_txIP = ip;
+	_txPort = port;
+	_txLength = 0;
+	return (_fd>=0) ? 1 : 0;
+}
+
+size_t PosixUDP::write(uint8_t c)
+{
+	return write(&c, 1);
+}
+
+size_t PosixUDP::write(const uint8_t* buffer, size_t size)
+{
+	if (size>(size_t) (POSIX_UDP_BUFFER - _txLength)) size = POSIX_UDP_BUFFER - _txLength;
+	memcpy(_tx + _txLength, buffer, size);
+	_txLength += size;
+	return size;
+}
+
+int PosixUDP::endPacket()
+{
+	if (_fd<0) return 0;
+	struct sockaddr_in address;
+	toSockaddr(_txIP, _txPort, address);
+	ssize_t n = sendto(_fd, _tx, _txLength, 0, (struct sockaddr*) &address, sizeof(address));
+	_txLength = 0;
+	return (n>=0) ? 1 : 0;
+}
+
+#endif
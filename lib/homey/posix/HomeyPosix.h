@@ -0,0 +1,106 @@
+#ifndef __HOMEY_POSIX__
+	#define __HOMEY_POSIX__
+
+	//BSD socket implementations of the client, server and UDP classes the Homey
+	//library expects from WiFi or Ethernet. All sockets are non-blocking so
+	//HomeyClass::loop() behaves as it does on a microcontroller; fd() exposes the
+	//descriptors for programs that want to wait for activity (poll, epoll).
+
+	#include <Arduino.h>
+
+	#define POSIX_RX_BUFFER		512		//Bytes read from a TCP socket per recv()
+	#define POSIX_TX_BUFFER		1024	//Bytes collected before a TCP send()
+	#define POSIX_UDP_BUFFER	1500	//Largest datagram sent or received
+	#define POSIX_CONNECT_TIMEOUT	1000	//Milliseconds to wait for an outgoing connection
+
+	class PosixClient : public Stream {
+		public:
+			PosixClient();
+			explicit PosixClient(int fd);
+			PosixClient(PosixClient&& other);
+			PosixClient& operator=(PosixClient&& other);
+			~PosixClient();
+
+			int connect(const IPAddress& ip, uint16_t port);
+			uint8_t connected();
+			void stop();
+			operator bool() const { return _fd>=0; }
+			int fd() const { return _fd; }
+
+			using Print::write;
+			size_t write(uint8_t c);
+			size_t write(const uint8_t* buffer, size_t size);
+			void flush();
+
+			int available();
+			int read();
+			int read(uint8_t* buffer, size_t size);
+			int peek();
+
+		private:
+			PosixClient(const PosixClient&);
+			PosixClient& operator=(const PosixClient&);
+			bool fill();													//Read what the socket has, false when it was closed
+
+			int _fd;
+			uint8_t _rx[POSIX_RX_BUFFER];
+			uint16_t _rxStart;
+			uint16_t _rxEnd;
+			uint8_t _tx[POSIX_TX_BUFFER];
+			uint16_t _txLength;
+	};
+
+	class PosixServer {
+		public:
+			PosixServer(uint16_t port);
+			~PosixServer();
+
+			void setAddress(const IPAddress& address) { _address = address; }	//Listen on this address only (before begin)
+			void begin();
+			void stop();
+			PosixClient available();										//Next pending connection, or an invalid client
+			int fd() const { return _fd; }
+
+		private:
+			IPAddress _address;
+			uint16_t _port;
+			int _fd;
+	};
+
+	class PosixUDP : public Stream {
+		public:
+			PosixUDP();
+			~PosixUDP();
+
+			uint8_t begin(uint16_t port);
+			uint8_t begin(const IPAddress& address, uint16_t port);			//Bound to one local address (0.0.0.0: all)
+			void stop();
+			int fd() const { return _fd; }
+
+			int parsePacket();												//Receive the next datagram, returns its size (0: none)
+			int available();
+			int read();
+			int read(uint8_t* buffer, size_t size);
+			int peek();
+			IPAddress remoteIP() const { return _remoteIP; }
+			uint16_t remotePort() const { return _remotePort; }
+
+			int beginPacket(const IPAddress& ip, uint16_t port);
+			using Print::write;
+			size_t write(uint8_t c);
+			size_t write(const uint8_t* buffer, size_t size);
+			int endPacket();
+
+		private:
+			int _fd;
+			uint8_t _rx[POSIX_UDP_BUFFER];
+			uint16_t _rxPosition;
+			uint16_t _rxLength;
+			IPAddress _remoteIP;
+			uint16_t _remotePort;
+			uint8_t _tx[POSIX_UDP_BUFFER];
+			uint16_t _txLength;
+			IPAddress _txIP;
+			uint16_t _txPort;
+	};
+#endif
@@ -0,0 +1,30 @@
+#ifndef __HOMEY_POSIX_PINS__
+	#define __HOMEY_POSIX_PINS__
+
+	//Simulated pin layout of the host build, shaped like a small Arduino board
+
+	#define NUM_DIGITAL_PINS	20
+	#define NUM_ANALOG_INPUTS	6
+
+	#define A0	14
+	#define A1	15
+	#define A2	16
+	#define A3	17
+	#define A4	18
+	#define A5	19
+
+	#define D0	0
+	#define D1	1
+	#define D2	2
+	#define D3	3
+	#define D4	4
+	#define D5	5
+	#define D6	6
+	#define D7	7
+	#define D8	8
+	#define D9	9
+	#define D10	10
+	#define D11	11
+	#define D12	12
+	#define D13	13
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+struct Asset {
+    const uint8_t *data = nullptr;
+    size_t size         = 0;
+
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// Read-only view of an asset container as written by tools/asset_pack.py. The
+// container is used in place, on the keypad straight from the memory mapped
+// assets partition and on a workstation from a file, so assets are never
+// copied. It has no platform dependencies.
+//
+// Layout, all numbers little endian:
+//
+//   header   "KPAK", uint16 version, uint16 count, uint32 size, uint32 crc32
+//   entries  count x { char name [24] (NUL padded), uint32 offset, uint32 size },
+//            sorted by name
+//   data     every asset starts at a multiple of 4 bytes
+//
+// size covers the whole container and crc32 (as zlib.crc32) the bytes after
+// the header.
+class AssetPack {
+public:
+    static constexpr uint16_t VERSION   = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t ENTRY_SIZE  = 32;
+    static constexpr size_t NAME_LENGTH = 24;  // Including the terminating NUL
+    static constexpr size_t ALIGNMENT   = 4;
+
+    enum Status : uint8_t {
+        OK,
+        EMPTY,         // Erased flash, nothing was ever written
+        BAD_HEADER,    // Not a container, another version or larger than the space it is in
+        BAD_TABLE,     // An entry outside the container, unterminated or out of order
+        BAD_CHECKSUM,  // Incomplete or damaged
+    };
+
+    // Checks the container at data, which may be followed by unused space up to capacity
+    Status open(const uint8_t *data, size_t capacity) {
+        close();
+        if (capacity < HEADER_SIZE) return BAD_HEADER;
+        if (read32(data) == 0xFFFFFFFF) return EMPTY;
+        if (memcmp(data, "KPAK", 4) != 0 || read16(data + 4) != VERSION) return BAD_HEADER;
+
+        uint16_t count = read16(data + 6);
+        uint32_t size  = read32(data + 8);
+        if (size > capacity || size < HEADER_SIZE + size_t(count) * ENTRY_SIZE) return BAD_HEADER;
+
+        const char *previous = nullptr;
+        for (uint16_t i = 0; i < count; i++) {
+            const uint8_t *entry = data + HEADER_SIZE + size_t(i) * ENTRY_SIZE;
+            const char *name     = reinterpret_cast<const char *>(entry);
+            uint32_t offset      = read32(entry + NAME_LENGTH);
+            uint32_t length      = read32(entry + NAME_LENGTH + 4);
+
+            if (memchr(name, '\0', NAME_LENGTH) == nullptr) return BAD_TABLE;
+            if (previous != nullptr && strcmp(previous, name) >= 0) return BAD_TABLE;
+            if (offset % ALIGNMENT != 0 || offset > size || length > size - offset) {
+                return BAD_TABLE;
+            }
+            previous = name;
+        }
+
+        if (crc32(data + HEADER_SIZE, size - HEADER_SIZE) != read32(data + 12)) return BAD_CHECKSUM;
+
+        _data  = data;
+        _count = count;
+        _size  = size;
+        return OK;
+    }
+
+    void close() {
+        _data  = nullptr;
+        _count = 0;
+        _size  = 0;
+    }
+
+    bool isOpen() const { return _data != nullptr; }
+    uint16_t count() const { return _count; }
+    size_t size() const { return _size; }
+
+    // Name and contents of the entry at index, in name order
+    const char *name(uint16_t index) const { return entryName(entryAt(index)); }
+    Asset asset(uint16_t index) const { return entryAsset(entryAt(index)); }
+
+    // The asset with the given name, an empty Asset when there is none
+    Asset find(const char *name) const {
+        uint16_t low = 0, high = _count;
+        while (low < high) {
+            uint16_t middle      = low + (high - low) / 2;
+            const uint8_t *entry = entryAt(middle);
+            int order            = strcmp(entryName(entry), name);
+            if (order == 0) return entryAsset(entry);
+            if (order < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return Asset {};
+    }
+
+    static const char *statusText(Status status) {
+        switch (status) {
+            case OK:
+                return "OK";
+            case EMPTY:
+                return "empty";
+            case BAD_HEADER:
+                return "bad header";
+            case BAD_TABLE:
+                return "bad entry table";
+            case BAD_CHECKSUM:
+                return "bad checksum";
+        }
+        return "unknown";
+    }
+
+    // CRC-32 (IEEE 802.3), the same as zlib.crc32 in the packer
+    static uint32_t crc32(const uint8_t *bytes, size_t length) {
+        uint32_t crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < length; i++) {
+            crc ^= bytes [i];
+            for (uint8_t bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+        return ~crc;
+    }
+
+private:
+    static uint16_t read16(const uint8_t *p) { return p [0] | p [1] << 8; }
+    static uint32_t read32(const uint8_t *p) { return read16(p) | uint32_t(read16(p + 2)) << 16; }
+
+    const uint8_t *entryAt(uint16_t index) const {
+        return _data + HEADER_SIZE + size_t(index) * ENTRY_SIZE;
+    }
+
+    static const char *entryName(const uint8_t *entry) {
+        return reinterpret_cast<const char *>(entry);
+    }
+
+    Asset entryAsset(const uint8_t *entry) const {
+        Asset asset;
+        asset.data = _data + read32(entry + NAME_LENGTH);
+        asset.size = read32(entry + NAME_LENGTH + 4);
+        return asset;
+    }
+
+    const uint8_t *_data = nullptr;
+    uint16_t _count      = 0;
+    size_t _size         = 0;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+#include <atomic>
+#include <mutex>
+
+#include "AssetPack.hpp"
+
+// The "assets" data partition (partitions.csv), memory mapped once at boot so
+// assets are read in place through the flash cache.
+//
+// An update over HTTP rewrites the partition behind the mapping, erasing a
+// sector just before it is written. Assets are therefore only read inside
+// read(), under a lock that beginUpdate() takes for as long as it needs to hide
+// them; release() then ends uses that outlive read(), such as a melody still
+// playing. While the update runs every reader falls back to its built-in
+// asset; afterwards the new container is checked outside the lock and swapped
+// in. An update that is never finished keeps the assets hidden until the next
+// update or reboot.
+class AssetPartition {
+public:
+    static constexpr const char *LABEL       = "assets";
+    static constexpr uint8_t SUBTYPE         = 0x40;   // First custom data subtype
+    static constexpr size_t SECTOR           = 4096;   // Flash erase unit
+    static constexpr uint32_t UPDATE_IDLE_MS = 10000;  // An update quiet this long was abandoned
+
+    enum Update {
+        STARTED,
+        NO_PARTITION,
+        BUSY,  // Another update is still being written
+    };
+
+    bool begin() {
+        _partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                              static_cast<esp_partition_subtype_t>(SUBTYPE), LABEL);
+        if (_partition == nullptr) {
+            Serial.println("No assets partition");
+            return false;
+        }
+
+        const void *mapped = nullptr;
+        if (esp_partition_mmap(_partition, 0, _partition->size, SPI_FLASH_MMAP_DATA, &mapped,
+                               &_mapping) != ESP_OK) {
+            Serial.println("Cannot map the assets partition");
+            _partition = nullptr;
+            return false;
+        }
+        _data   = static_cast<const uint8_t *>(mapped);
+        _status = _pack.open(_data, _partition->size);
+        Serial.printf("Assets: %s, %u entries\n", AssetPack::statusText(_status), _pack.count());
+        return _status == AssetPack::OK;
+    }
+
+    // Calls reader with the named asset, an empty Asset when there is none or an
+    // update is running. The asset stays valid until reader returns, so keep it short.
+    template <typename Reader>
+    void read(const char *name, Reader reader) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        reader(_pack.find(name));
+    }
+
+    // True once after the assets were hidden or replaced, so screens can be redrawn
+    bool changed() { return _changed.exchange(false, std::memory_order_acquire); }
+
+    AssetPack::Status status() const { return _status; }
+
+    // Starts rewriting the partition. The assets are hidden first and release()
+    // runs before the first sector is erased.
+    Update beginUpdate(void (*release)()) {
+        if (_partition == nullptr) return NO_PARTITION;
+        if (_updating && millis() - _lastWriteMs < UPDATE_IDLE_MS) return BUSY;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pack.close();
+        }
+        release();
+        _changed.store(true, std::memory_order_release);
+        _updating    = true;
+        _lastWriteMs = millis();
+        _written     = 0;
+        _erased      = 0;
+        return STARTED;
+    }
+
+    // Appends the next bytes of the new container
+    bool write(const uint8_t *bytes, size_t length) {
+        size_t end   = _written + length;
+        _lastWriteMs = millis();
+        if (end > _partition->size) return false;
+
+        if (end > _erased) {
+            size_t erase = (end - _erased + SECTOR - 1) / SECTOR * SECTOR;
+            if (esp_partition_erase_range(_partition, _erased, erase) != ESP_OK) return false;
+            _erased += erase;
+        }
+        if (esp_partition_write(_partition, _written, bytes, length) != ESP_OK) return false;
+        _written = end;
+        return true;
+    }
+
+    // Checks what was written and makes it visible when it is a valid container
+    AssetPack::Status endUpdate() {
+        AssetPack pack;
+        _status = pack.open(_data, _partition->size);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pack = pack;
+        }
+        _updating = false;
+        _changed.store(true, std::memory_order_release);
+        return _status;
+    }
+
+    // Status, then one "<name> <size>" line per asset
+    void print(Print &out) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        out.printf("%s, %u entries, %u bytes\n", AssetPack::statusText(_status), _pack.count(),
+                   unsigned(_pack.size()));
+        for (uint16_t i = 0; i < _pack.count(); i++) {
+            out.printf("%s %u\n", _pack.name(i), unsigned(_pack.asset(i).size));
+        }
+    }
+
+private:
+    const esp_partition_t *_partition = nullptr;
+    spi_flash_mmap_handle_t _mapping  = 0;
+    const uint8_t *_data              = nullptr;
+    std::mutex _mutex;  // Held while an asset is read and while the assets are hidden
+    AssetPack _pack;
+    AssetPack::Status _status = AssetPack::EMPTY;
+    std::atomic<bool> _changed { false };
+
+    // Only touched by the web server
+    bool _updating        = false;
+    uint32_t _lastWriteMs = 0;
+    size_t _written       = 0;
+    size_t _erased        = 0;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#include <mutex>
+
+#include "Melody.hpp"
+
+// Plays melodies on a buzzer without blocking the caller.
+//
+// The buzzer is driven by an LEDC channel and a one-shot esp_timer steps to
+// the next note when the current one has had its duration, so playback runs
+// in the timer task while loop() carries on. The current melody and the ones
+// queued behind it share a small fixed list; a melody may only replace the
+// current one when its priority is at least as high.
+class AudioSequencer {
+public:
+    enum Priority : uint8_t {
+        MELODY,    // Tunes, interrupted by anything
+        CLICK,     // Key clicks
+        FEEDBACK,  // Success, acknowledge and error tones
+    };
+
+    static constexpr uint8_t MAX_MELODIES    = 4;  // The current one and the ones queued
+    static constexpr uint8_t RESOLUTION_BITS = 10;
+
+    AudioSequencer(uint8_t pin, uint8_t channel) : _pin(pin), _channel(channel) {}
+
+    void begin() {
+        ledcSetup(_channel, 2000, RESOLUTION_BITS);
+        ledcAttachPin(_pin, _channel);
+        ledcWriteTone(_channel, 0);
+
+        esp_timer_create_args_t timer = {};
+        timer.callback                = timerEntry;
+        timer.arg                     = this;
+        timer.dispatch_method         = ESP_TIMER_TASK;
+        timer.name                    = "audio";
+        esp_timer_create(&timer, &_timer);
+    }
+
+    // Replaces the current melody, the queued ones still follow. False when a
+    // melody with a higher priority is playing.
+    bool play(const Melody &melody, Priority priority) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_count > 0 && _entries [0].priority > priority) return false;
+            _entries [0] = Entry { &melody, priority, {} };
+            if (_count == 0) _count = 1;
+        }
+        restart();
+        return true;
+    }
+
+    // Plays the melody after the current and queued ones, right away when idle.
+    // False when the queue is full.
+    bool queue(const Melody &melody, Priority priority) {
+        bool idle;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_count == MAX_MELODIES) return false;
+            idle                = _count == 0;
+            _entries [_count++] = Entry { &melody, priority, {} };
+        }
+        if (idle) restart();
+        return true;
+    }
+
+    // Silences the buzzer and forgets the queue
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _count = 0;
+        }
+        esp_timer_stop(_timer);
+        ledcWriteTone(_channel, 0);
+    }
+
+    bool isPlaying() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count > 0;
+    }
+
+private:
+    struct Entry {
+        const Melody *melody;
+        Priority priority;
+        MelodyCursor cursor;
+    };
+
+    static void timerEntry(void *arg) { static_cast<AudioSequencer *>(arg)->step(); }
+
+    // Starts the next note now instead of when the current one ends
+    void restart() {
+        esp_timer_stop(_timer);
+        while (esp_timer_start_once(_timer, 0) == ESP_ERR_INVALID_STATE) {
+            esp_timer_stop(_timer);  // step() armed it again in the meantime
+        }
+    }
+
+    // Runs in the esp_timer task: sounds the next note and arms the timer for its end
+    void step() {
+        Note note;
+        bool playing = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            while (_count > 0 && !playing) {
+                playing = _entries [0].melody->next(_entries [0].cursor, note);
+                if (!playing) {
+                    for (uint8_t i = 1; i < _count; i++) _entries [i - 1] = _entries [i];
+                    _count--;
+                }
+            }
+        }
+
+        ledcWriteTone(_channel, playing ? note.frequency : 0);
+        if (playing) esp_timer_start_once(_timer, uint64_t(note.durationMs) * 1000);
+    }
+
+    uint8_t _pin;
+    uint8_t _channel;
+    esp_timer_handle_t _timer = nullptr;
+
+    std::mutex _mutex;  // Guards the entries, shared with the timer task
+    Entry _entries [MAX_MELODIES];
+    uint8_t _count = 0;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Font5x7.hpp"
+
+// One full display bank (84x8 pixels) of fixed text, rendered by the compiler.
+// Declare banners constexpr so they end up in flash; drawing one is a copy of
+// its columns into a framebuffer bank.
+struct Banner {
+    static constexpr uint8_t COLUMNS = 84;
+
+    enum Align : uint8_t {
+        LEFT,
+        CENTER,
+    };
+
+    uint8_t columns [COLUMNS];
+
+    static constexpr Banner render(const char *text, Align align = CENTER) {
+        Banner banner {};
+
+        uint8_t length = 0;
+        while (text [length] != '\0' && (length + 1) * Font5x7::ADVANCE <= COLUMNS + 1) length++;
+        uint8_t width  = length > 0 ? length * Font5x7::ADVANCE - 1 : 0;
+        uint8_t column = align == CENTER ? (COLUMNS - width) / 2 : 0;
+
+        for (uint8_t i = 0; i < length; i++) {
+            const uint8_t *glyph = Font5x7::glyph(text [i]);
+            for (uint8_t x = 0; x < Font5x7::WIDTH; x++) banner.columns [column + x] = glyph [x];
+            column += Font5x7::ADVANCE;
+        }
+        return banner;
+    }
+};
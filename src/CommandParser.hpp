@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Non-owning view into a command buffer
+struct TextView {
+    const char *data;
+    size_t length;
+};
+
+// Keys typed since the last '#', stored inline. Once full, further keys are
+// dropped and the entry is marked as overflowed, so a stuck key cannot grow it.
+class CommandBuffer {
+public:
+    static constexpr size_t CAPACITY = 32;
+
+    bool append(char c) {
+        if (_length >= CAPACITY) {
+            _overflowed = true;
+            return false;
+        }
+        _data [_length++] = c;
+        return true;
+    }
+
+    void clear() {
+        _length     = 0;
+        _overflowed = false;
+    }
+
+    bool overflowed() const { return _overflowed; }
+    TextView view() const { return TextView { _data, _length }; }
+
+private:
+    char _data [CAPACITY];
+    size_t _length   = 0;
+    bool _overflowed = false;
+};
+
+// "<pin>[*<command>[*<argument>]]"; missing parts are empty views
+struct ParsedCommand {
+    TextView pin;
+    TextView command;
+    TextView argument;  // Everything after the second '*'
+};
+
+class CommandParser {
+public:
+    static constexpr size_t MAX_DIGITS = 9;  // Always fits in an int
+
+    // Splits the entry in a single pass, without copying
+    static ParsedCommand split(TextView text) {
+        ParsedCommand parsed = { { text.data, 0 }, { text.data + text.length, 0 },
+                                 { text.data + text.length, 0 } };
+        TextView *field      = &parsed.pin;
+
+        for (size_t i = 0; i < text.length; i++) {
+            if (text.data [i] == '*' && field != &parsed.argument) {
+                field         = (field == &parsed.pin) ? &parsed.command : &parsed.argument;
+                field->data   = text.data + i + 1;
+                field->length = 0;
+                continue;
+            }
+            field->length++;
+        }
+        return parsed;
+    }
+
+    static bool isDigits(TextView text) {
+        for (size_t i = 0; i < text.length; i++) {
+            if (text.data [i] < '0' || text.data [i] > '9') return false;
+        }
+        return true;
+    }
+
+    // Decimal digits only; an empty view is 0
+    static bool parseNumber(TextView text, int &value) {
+        if (text.length > MAX_DIGITS || !isDigits(text)) return false;
+        value = 0;
+        for (size_t i = 0; i < text.length; i++) value = value * 10 + (text.data [i] - '0');
+        return true;
+    }
+};
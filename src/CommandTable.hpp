@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "CommandParser.hpp"
+
+// Keypad command, entered as <pin>*<code>[*<argument>]
+struct Command {
+    int code;
+    void (*handler)(TextView argument);
+    bool takesArgument;  // The argument is required when set and rejected otherwise
+};
+
+// Lookup in a constexpr array of commands sorted by code. The array lives in
+// flash and is searched by bisection, so there are no static constructors and
+// no heap. Check the order with a static_assert on isSortedAndUnique().
+class CommandTable {
+public:
+    template <size_t N>
+    static constexpr bool isSortedAndUnique(const Command (&commands) [N]) {
+        for (size_t i = 1; i < N; i++) {
+            if (commands [i - 1].code >= commands [i].code) return false;
+        }
+        return true;
+    }
+
+    // Command with the given code, nullptr when there is none
+    template <size_t N>
+    static const Command *find(const Command (&commands) [N], int code) {
+        size_t low = 0, high = N;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (commands [middle].code < code) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return (low < N && commands [low].code == code) ? &commands [low] : nullptr;
+    }
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Keypad code defined at runtime and stored in NVS
+struct CustomCommand {
+    static constexpr size_t NAME_SIZE  = 32;
+    static constexpr size_t VALUE_SIZE = 16;
+
+    enum Action : uint8_t {
+        TRIGGER    = 0,  // Homey.trigger(name)
+        CAPABILITY = 1,  // Homey.setCapabilityValue(name, value)
+        BUILTIN    = 2,  // Built-in command whose code is in value
+    };
+
+    int32_t code;
+    uint8_t action;
+    char name [NAME_SIZE];
+    char value [VALUE_SIZE];
+};
+
+// Immutable snapshot of the custom commands with an open addressing hash
+// index, so a lookup costs the same for ten entries or a few hundred.
+class CustomCommandSet {
+public:
+    CustomCommandSet(const CustomCommand *commands, size_t count)
+        : _commands(new CustomCommand [count]) {
+        memcpy(_commands.get(), commands, count * sizeof(CustomCommand));
+
+        size_t slots = 8;
+        while (slots < count * 2) slots <<= 1;  // Keep the load factor at or below one half
+        _mask = slots - 1;
+        _index.reset(new uint16_t [slots]);
+        for (size_t slot = 0; slot < slots; slot++) _index [slot] = EMPTY;
+
+        for (size_t i = 0; i < count; i++) {
+            size_t slot = hash(commands [i].code) & _mask;
+            while (_index [slot] != EMPTY) slot = (slot + 1) & _mask;
+            _index [slot] = i;
+        }
+    }
+
+    // Command with the given code, nullptr when there is none
+    const CustomCommand *find(int32_t code) const {
+        for (size_t slot = hash(code) & _mask;; slot = (slot + 1) & _mask) {
+            uint16_t i = _index [slot];
+            if (i == EMPTY) return nullptr;
+            if (_commands [i].code == code) return &_commands [i];
+        }
+    }
+
+private:
+    static constexpr uint16_t EMPTY = 0xFFFF;
+
+    static uint32_t hash(int32_t code) {
+        uint32_t h = static_cast<uint32_t>(code) * 0x9E3779B1u;
+        return h ^ (h >> 16);
+    }
+
+    std::unique_ptr<CustomCommand []> _commands;
+    std::unique_ptr<uint16_t []> _index;
+    size_t _mask;
+};
+
+// Custom commands, edited from the web server and looked up from loop().
+//
+// Every edit is written to NVS and only then published as a new
+// CustomCommandSet, so a failed write leaves both unchanged. loop() adopts it in
+// apply() before handling keys, so a command is either entirely old or entirely
+// new and the set in use is never freed under a lookup.
+//
+// The table is one NVS blob of MAX_COMMANDS * 56 bytes (3.5 KB). It shares the
+// 20 KB nvs partition (about 16 KB usable) with the user table and WiFi, and a
+// rewrite briefly holds the old and the new blob. A full table takes three
+// copies on the heap while an edit is pending, about 11 KB.
+class CustomCommands {
+public:
+    static constexpr size_t MAX_COMMANDS = 64;
+
+    ~CustomCommands() { delete _pending.exchange(nullptr); }
+
+    void begin() {
+        _preferences.begin("commands", false);
+
+        size_t length = _preferences.getBytesLength("table");
+        if (length > 0 && length % sizeof(CustomCommand) == 0) {
+            _entries.resize(length / sizeof(CustomCommand));
+            _preferences.getBytes("table", _entries.data(), length);
+        }
+        _active.reset(new CustomCommandSet(_entries.data(), _entries.size()));
+    }
+
+    // Adopts the latest edit, call from loop() only
+    void apply() {
+        CustomCommandSet *pending = _pending.exchange(nullptr, std::memory_order_acquire);
+        if (pending != nullptr) _active.reset(pending);
+    }
+
+    // Call from loop() only
+    const CustomCommand *find(int32_t code) const { return _active->find(code); }
+
+    // Adds or replaces the command with the same code. False when the table is
+    // full or NVS could not be written; nothing changes then.
+    bool put(const CustomCommand &command) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<CustomCommand> entries = _entries;
+        for (CustomCommand &entry : entries) {
+            if (entry.code == command.code) {
+                entry = command;
+                return publish(std::move(entries));
+            }
+        }
+        if (entries.size() >= MAX_COMMANDS) return false;
+        entries.push_back(command);
+        return publish(std::move(entries));
+    }
+
+    // False when there is no command with this code, or when NVS could not be written
+    bool remove(int32_t code) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i < _entries.size(); i++) {
+            if (_entries [i].code == code) {
+                std::vector<CustomCommand> entries = _entries;
+                entries.erase(entries.begin() + i);
+                return publish(std::move(entries));
+            }
+        }
+        return false;
+    }
+
+    // One "<code> trigger <name>", "<code> capability <name> <value>" or
+    // "<code> builtin <code>" line per command
+    void print(Print &out) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const CustomCommand &entry : _entries) {
+            if (entry.action == CustomCommand::TRIGGER) {
+                out.printf("%ld trigger %s\n", (long)entry.code, entry.name);
+            } else if (entry.action == CustomCommand::CAPABILITY) {
+                out.printf("%ld capability %s %s\n", (long)entry.code, entry.name, entry.value);
+            } else {
+                out.printf("%ld builtin %s\n", (long)entry.code, entry.value);
+            }
+        }
+    }
+
+private:
+    // Stores the edited table and adopts it, false and unchanged when NVS refuses it
+    bool publish(std::vector<CustomCommand> entries) {
+        // putBytes() refuses an empty blob, so the last removal deletes the key
+        size_t length = entries.size() * sizeof(CustomCommand);
+        bool stored   = entries.empty()
+                            ? _preferences.remove("table")
+                            : _preferences.putBytes("table", entries.data(), length) == length;
+        if (!stored) return false;
+
+        _entries               = std::move(entries);
+        CustomCommandSet *next = new CustomCommandSet(_entries.data(), _entries.size());
+        delete _pending.exchange(next, std::memory_order_release);  // Never adopted by loop()
+        return true;
+    }
+
+    Preferences _preferences;
+    std::mutex _mutex;                                     // Serializes edits of _entries
+    std::vector<CustomCommand> _entries;                   // Source of truth, as stored in NVS
+    std::unique_ptr<CustomCommandSet> _active;             // Used by loop()
+    std::atomic<CustomCommandSet *> _pending { nullptr };  // Published, not yet adopted
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+
+#include "Pcd8544Display.hpp"
+
+// Pushes frames to the display from its own FreeRTOS task on the other core.
+//
+// There are two frames. The application draws a complete frame into the back
+// one and submits it; the task then swaps the two and sends the new front
+// frame to the panel, so the panel never shows half a frame and loop() never
+// waits on the bus. Until the task has taken a submitted frame the back frame
+// is still in use, beginFrame() returns nullptr and the caller tries again on
+// its next loop(). After begin() only the task talks to the display.
+class DisplayRenderer {
+public:
+    static constexpr uint32_t STACK_SIZE  = 3072;
+    static constexpr UBaseType_t PRIORITY = 2;  // Above loop(), the panel is only a short burst
+    static constexpr BaseType_t CORE      = 0;  // Away from loop() and the keypad on core 1
+
+    explicit DisplayRenderer(Pcd8544Display &display) : _display(display), _canvas(_frames [1]) {}
+
+    void begin() {
+        xTaskCreatePinnedToCore(taskEntry, "display", STACK_SIZE, this, PRIORITY, &_task, CORE);
+    }
+
+    // Canvas over the back frame, nullptr while the task has not taken the previous frame.
+    // Its contents are those of an older frame, so a frame is drawn in full.
+    Pcd8544Canvas *beginFrame() {
+        if (_pending.load(std::memory_order_acquire)) return nullptr;
+        return &_canvas;
+    }
+
+    // Hands the frame drawn since beginFrame() to the task
+    void submitFrame() {
+        _submitted.fetch_add(1, std::memory_order_relaxed);
+        _pending.store(true, std::memory_order_release);
+        xTaskNotifyGive(_task);
+    }
+
+    uint32_t framesSubmitted() const { return _submitted.load(std::memory_order_relaxed); }
+    uint32_t framesPushed() const { return _pushed.load(std::memory_order_relaxed); }
+
+private:
+    static void taskEntry(void *arg) { static_cast<DisplayRenderer *>(arg)->run(); }
+
+    void run() {
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            if (!_pending.load(std::memory_order_acquire)) continue;
+
+            // The submitted back frame becomes the front; the old front is on the panel already
+            uint8_t front = 1 - _front;
+            _front        = front;
+            _canvas.setFrame(_frames [1 - front]);
+            _pending.store(false, std::memory_order_release);
+
+            _display.display(_frames [front]);
+            _pushed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    Pcd8544Display &_display;
+    Pcd8544Canvas::Frame _frames [2] = {};
+    Pcd8544Canvas _canvas;  // Draws into the back frame
+    uint8_t _front = 0;     // Only touched by the task
+    std::atomic<bool> _pending { false };
+    std::atomic<uint32_t> _submitted { 0 };
+    std::atomic<uint32_t> _pushed { 0 };
+    TaskHandle_t _task = nullptr;
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+
+#include "SpscQueue.hpp"
+
+struct KeyEvent {
+    char key;
+    int64_t timestampUs;  // esp_timer_get_time() when the contact was first seen
+};
+
+// Driver for a row/column key matrix, scanned from its own FreeRTOS task.
+//
+// Rows are open drain: a row is either pulled low or left floating, never
+// driven high, so two keys held in one column cannot short a high row to a low
+// one. While idle all rows are pulled low and the task sleeps until a column
+// interrupt fires, so an untouched keypad costs no CPU. Once a key goes down
+// the matrix is scanned every scanPeriodMs until all keys are released and
+// debounced. Each key has an integrating debounce counter: it counts up while
+// the contact reads closed and down while it reads open, and the key changes
+// state only when the counter reaches 0 or `integrate`.
+//
+// Presses are queued with a timestamp and drained by loop() through next().
+class MatrixKeypad {
+public:
+    static constexpr uint8_t MAX_ROWS       = 4;
+    static constexpr uint8_t MAX_COLS       = 4;
+    static constexpr size_t QUEUE_SIZE      = 16;
+    static constexpr uint32_t STACK_SIZE    = 2048;
+    static constexpr UBaseType_t PRIORITY   = 15;  // Above loop() and AsyncTCP, below WiFi
+    static constexpr BaseType_t CORE        = 1;
+    static constexpr uint32_t ROW_SETTLE_US = 5;  // Let the column lines follow a row change
+
+    struct Debounce {
+        uint8_t scanPeriodMs;  // Scan period while a key is down
+        uint8_t integrate;     // Consecutive scans needed to accept a press or release
+    };
+
+    MatrixKeypad(const char *keymap, const uint8_t *rowPins, const uint8_t *colPins, uint8_t rows,
+                 uint8_t cols, Debounce debounce)
+        : _keymap(keymap),
+          _rowPins(rowPins),
+          _colPins(colPins),
+          _rows(rows < MAX_ROWS ? rows : MAX_ROWS),
+          _cols(cols < MAX_COLS ? cols : MAX_COLS),
+          _debounce(debounce) {}
+
+    void begin() {
+        for (uint8_t c = 0; c < _cols; c++) pinMode(_colPins [c], INPUT_PULLUP);
+        for (uint8_t r = 0; r < _rows; r++) pinMode(_rowPins [r], OUTPUT_OPEN_DRAIN);
+        driveAllRows();
+
+        xTaskCreatePinnedToCore(taskEntry, "keypad", STACK_SIZE, this, PRIORITY, &_task, CORE);
+        for (uint8_t c = 0; c < _cols; c++) {
+            attachInterruptArg(digitalPinToInterrupt(_colPins [c]), columnInterrupt, this, FALLING);
+        }
+    }
+
+    // Next queued key press, false when there is none
+    bool next(KeyEvent &event) { return _queue.pop(event); }
+
+    // Presses dropped because loop() did not drain the queue in time
+    uint32_t overflows() const { return _queue.overflows(); }
+
+    // Scans that started late because the task could not run on time
+    uint32_t lateScans() const { return _lateScans.load(std::memory_order_relaxed); }
+
+private:
+    static void IRAM_ATTR columnInterrupt(void *arg) {
+        MatrixKeypad *keypad = static_cast<MatrixKeypad *>(arg);
+        if (keypad->_task == nullptr) return;
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(keypad->_task, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+
+    static void taskEntry(void *arg) { static_cast<MatrixKeypad *>(arg)->run(); }
+
+    void run() {
+        for (;;) {
+            // Idle: sleep until a column is pulled low by any key
+            driveAllRows();
+            ulTaskNotifyTake(pdTRUE, 0);  // Forget edges caused by our own scanning
+            if (!anyColumnLow()) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            // Active: scan at full rate until everything is released
+            TickType_t lastWake = xTaskGetTickCount();
+            while (scan()) {
+                if (xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(_debounce.scanPeriodMs)) == pdFALSE) {
+                    _lateScans.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    // One pass over the matrix, returns true while any key is down or still settling
+    bool scan() {
+        bool busy   = false;
+        int64_t now = esp_timer_get_time();
+
+        for (uint8_t r = 0; r < _rows; r++) {
+            for (uint8_t other = 0; other < _rows; other++) {
+                digitalWrite(_rowPins [other], other == r ? LOW : HIGH);  // HIGH releases the row
+            }
+            delayMicroseconds(ROW_SETTLE_US);
+
+            for (uint8_t c = 0; c < _cols; c++) {
+                uint8_t index  = r * _cols + c;
+                bool closed    = digitalRead(_colPins [c]) == LOW;
+                uint8_t &count = _counts [index];
+                uint16_t bit   = 1u << index;
+
+                if (closed && count < _debounce.integrate) {
+                    if (count == 0) _onsetUs [index] = now;
+                    count++;
+                } else if (!closed && count > 0) {
+                    count--;
+                }
+
+                if (count == _debounce.integrate && !(_pressed & bit)) {
+                    _pressed |= bit;
+                    _queue.push(KeyEvent { _keymap [index], _onsetUs [index] });
+                } else if (count == 0) {
+                    _pressed &= ~bit;
+                }
+
+                if (count > 0) busy = true;
+            }
+        }
+        return busy;
+    }
+
+    void driveAllRows() {
+        for (uint8_t r = 0; r < _rows; r++) digitalWrite(_rowPins [r], LOW);
+        delayMicroseconds(ROW_SETTLE_US);
+    }
+
+    bool anyColumnLow() {
+        for (uint8_t c = 0; c < _cols; c++) {
+            if (digitalRead(_colPins [c]) == LOW) return true;
+        }
+        return false;
+    }
+
+    const char *_keymap;
+    const uint8_t *_rowPins;
+    const uint8_t *_colPins;
+    uint8_t _rows;
+    uint8_t _cols;
+    Debounce _debounce;
+
+    uint8_t _counts [MAX_ROWS * MAX_COLS]  = {};
+    int64_t _onsetUs [MAX_ROWS * MAX_COLS] = {};
+    uint16_t _pressed                      = 0;
+
+    TaskHandle_t _task = nullptr;
+    SpscQueue<KeyEvent, QUEUE_SIZE> _queue;
+    std::atomic<uint32_t> _lateScans { 0 };
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct Note {
+    uint16_t frequency;  // Hz, 0 is a rest
+    uint16_t durationMs;
+};
+
+// Where playback of a melody stands. Melodies are immutable, so the same one
+// can be playing and queued at once; what the fields mean is up to the melody.
+struct MelodyCursor {
+    uint32_t position;
+    uint32_t state;
+};
+
+// A sequence of notes, read one note at a time
+class Melody {
+public:
+    // Next note after the cursor, false after the last one
+    virtual bool next(MelodyCursor &cursor, Note &note) const = 0;
+};
+
+// Melody stored as a plain array of notes
+class NoteList : public Melody {
+public:
+    template <size_t N>
+    constexpr NoteList(const Note (&notes) [N]) : _notes(notes), _length(N) {}
+
+    bool next(MelodyCursor &cursor, Note &note) const override {
+        if (cursor.position >= _length) return false;
+        note = _notes [cursor.position++];
+        return true;
+    }
+
+private:
+    const Note *_notes;
+    size_t _length;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Melody.hpp"
+
+// Melody in the note stream written by tools/melody_stream.py, decoded one
+// note at a time straight from flash. Each note starts with a byte holding an
+// index into the frequency table (bits 0-5) and a flag (bit 6) for "same
+// duration as the previous note"; without the flag the duration follows as an
+// unsigned LEB128 varint. The cursor keeps the byte offset and the previous
+// duration.
+//
+// As an asset (tools/asset_pack.py) the melody is one block: uint8 number of
+// frequencies, a zero byte, the frequencies as uint16 and then the notes.
+class MelodyStream : public Melody {
+public:
+    static constexpr uint8_t INDEX_MASK    = 0x3F;
+    static constexpr uint8_t SAME_DURATION = 0x40;
+
+    template <size_t F, size_t N>
+    constexpr MelodyStream(const uint16_t (&frequencies) [F], const uint8_t (&notes) [N])
+        : MelodyStream(frequencies, F, notes, N) {}
+
+    constexpr MelodyStream(const uint16_t *frequencies, size_t frequencyCount, const uint8_t *notes,
+                           size_t length)
+        : _frequencies(frequencies),
+          _frequencyCount(frequencyCount),
+          _notes(notes),
+          _length(length) {}
+
+    constexpr MelodyStream() : MelodyStream(nullptr, 0, nullptr, 0) {}
+
+    // Uses a melody asset in place, false when it is too short. The asset must stay mapped.
+    static bool parse(const uint8_t *asset, size_t size, MelodyStream &melody) {
+        if (size < 2) return false;
+        size_t header = 2 + size_t(asset [0]) * sizeof(uint16_t);
+        bool aligned  = reinterpret_cast<uintptr_t>(asset) % alignof(uint16_t) == 0;
+        if (size < header || !aligned) return false;
+
+        const uint16_t *frequencies = reinterpret_cast<const uint16_t *>(asset + 2);
+
+        melody = MelodyStream(frequencies, asset [0], asset + header, size - header);
+        return true;
+    }
+
+    bool next(MelodyCursor &cursor, Note &note) const override {
+        if (cursor.position >= _length) return false;
+
+        uint8_t head      = _notes [cursor.position++];
+        uint32_t duration = cursor.state;
+        if (!(head & SAME_DURATION)) {
+            duration = 0;
+            for (uint8_t shift = 0; shift < 21 && cursor.position < _length; shift += 7) {
+                uint8_t byte = _notes [cursor.position++];
+                duration |= uint32_t(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) break;
+            }
+        }
+
+        uint8_t index   = head & INDEX_MASK;
+        note.frequency  = index < _frequencyCount ? _frequencies [index] : 0;
+        note.durationMs = duration;
+        cursor.state    = duration;
+        return true;
+    }
+
+private:
+    const uint16_t *_frequencies;
+    size_t _frequencyCount;
+    const uint8_t *_notes;
+    size_t _length;
+};
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <Arduino.h>
+
+#include "Font5x7.hpp"
+
+#ifndef BLACK
+#define BLACK 1
+#define WHITE 0
+#endif
+
+// Byte transport to a PCD8544, the D/C line selects commands or display data
+class Pcd8544Bus {
+public:
+    virtual ~Pcd8544Bus() {}
+    virtual void begin()                                      = 0;  // Pins, reset pulse
+    virtual void command(const uint8_t *bytes, size_t length) = 0;
+    virtual void data(const uint8_t *bytes, size_t length)    = 0;
+};
+
+// Bit-banged SPI on any five pins, like the pin constructor of Adafruit_PCD8544
+class Pcd8544SoftwareBus : public Pcd8544Bus {
+public:
+    Pcd8544SoftwareBus(int8_t clkPin, int8_t dinPin, int8_t dcPin, int8_t cePin, int8_t rstPin)
+        : _clkPin(clkPin), _dinPin(dinPin), _dcPin(dcPin), _cePin(cePin), _rstPin(rstPin) {}
+
+    void begin() override {
+        pinMode(_clkPin, OUTPUT);
+        pinMode(_dinPin, OUTPUT);
+        pinMode(_dcPin, OUTPUT);
+        pinMode(_cePin, OUTPUT);
+        pinMode(_rstPin, OUTPUT);
+        digitalWrite(_cePin, HIGH);
+        digitalWrite(_clkPin, LOW);
+
+        digitalWrite(_rstPin, LOW);
+        delay(1);
+        digitalWrite(_rstPin, HIGH);
+    }
+
+    void command(const uint8_t *bytes, size_t length) override { transfer(LOW, bytes, length); }
+    void data(const uint8_t *bytes, size_t length) override { transfer(HIGH, bytes, length); }
+
+private:
+    void transfer(uint8_t dc, const uint8_t *bytes, size_t length) {
+        digitalWrite(_dcPin, dc);
+        digitalWrite(_cePin, LOW);
+        for (size_t i = 0; i < length; i++) {
+            for (uint8_t bit = 0x80; bit != 0; bit >>= 1) {
+                digitalWrite(_dinPin, (bytes [i] & bit) ? HIGH : LOW);
+                digitalWrite(_clkPin, HIGH);
+                digitalWrite(_clkPin, LOW);
+            }
+        }
+        digitalWrite(_cePin, HIGH);
+    }
+
+    int8_t _clkPin;
+    int8_t _dinPin;
+    int8_t _dcPin;
+    int8_t _cePin;
+    int8_t _rstPin;
+};
+
+// Drawing surface in the memory layout of the PCD8544: 6 banks of 84 bytes,
+// one byte per column of 8 pixels with bit 0 at the top. It draws into a frame
+// it does not own, so the frames of a render task can be drawn in turn.
+class Pcd8544Canvas : public Adafruit_GFX {
+public:
+    static constexpr uint8_t PANEL_WIDTH  = 84;
+    static constexpr uint8_t PANEL_HEIGHT = 48;
+    static constexpr uint8_t BANKS        = PANEL_HEIGHT / 8;
+
+    typedef uint8_t Frame [BANKS][PANEL_WIDTH];
+
+    explicit Pcd8544Canvas(Frame &frame)
+        : Adafruit_GFX(PANEL_WIDTH, PANEL_HEIGHT), _frame(frame) {}
+
+    // Draws into another frame from now on
+    void setFrame(Frame &frame) { _frame = frame; }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || x >= PANEL_WIDTH || y < 0 || y >= PANEL_HEIGHT) return;
+
+        uint8_t &column = _frame [y >> 3][x];
+        if (color == BLACK) {
+            column |= 1 << (y & 7);
+        } else {
+            column &= ~(1 << (y & 7));
+        }
+    }
+
+    void fillScreen(uint16_t color) override {
+        memset(_frame, color == BLACK ? 0xFF : 0x00, sizeof(Frame));
+    }
+
+    void clearDisplay() { fillScreen(WHITE); }
+
+    // Replaces a whole bank with PANEL_WIDTH prepared columns, for example a Banner
+    void drawBank(uint8_t bank, const uint8_t *columns) {
+        if (bank >= BANKS) return;
+        memcpy(_frame [bank], columns, PANEL_WIDTH);
+    }
+
+    // Writes text in the 5x7 font straight into the framebuffer bytes, black on white. Every
+    // character is a 6x8 cell that replaces what was below it. When y is a multiple of 8 a
+    // cell column is exactly one byte of a bank; otherwise each column is shifted across the
+    // two banks it overlaps. Returns the x after the text.
+    int16_t drawText(int16_t x, int16_t y, const char *text, size_t length) {
+        int16_t to = x + length * Font5x7::ADVANCE;
+        if (y <= -8 || y >= PANEL_HEIGHT || to <= 0 || x >= PANEL_WIDTH) return to;
+
+        int8_t bank   = y >> 3;  // -1 when the text starts above the panel
+        uint8_t shift = y & 7;
+        for (size_t i = 0; i < length; i++) {
+            const uint8_t *glyph = Font5x7::glyph(text [i]);
+            for (uint8_t column = 0; column < Font5x7::ADVANCE; column++, x++) {
+                if (x < 0 || x >= PANEL_WIDTH) continue;
+                uint8_t bits = column < Font5x7::WIDTH ? glyph [column] : 0;
+
+                if (shift == 0) {
+                    _frame [bank][x] = bits;
+                    continue;
+                }
+                if (bank >= 0) {
+                    uint8_t &upper = _frame [bank][x];
+                    upper          = (upper & ~(0xFF << shift)) | (bits << shift);
+                }
+                if (bank + 1 < BANKS) {
+                    uint8_t &lower = _frame [bank + 1][x];
+                    lower          = (lower & ~(0xFF >> (8 - shift))) | (bits >> (8 - shift));
+                }
+            }
+        }
+        return to;
+    }
+
+    int16_t drawText(int16_t x, int16_t y, const char *text) {
+        return drawText(x, y, text, strlen(text));
+    }
+
+private:
+    uint8_t (*_frame) [PANEL_WIDTH];
+};
+
+// 84x48 Nokia 5110 display with partial updates.
+//
+// Frames are drawn elsewhere, with a Pcd8544Canvas. display(frame) compares
+// every column with what the panel already shows and sends only the changed
+// runs, each preceded by the bank and column address unless the controller's
+// address counter is already there.
+class Pcd8544Display {
+public:
+    typedef Pcd8544Canvas::Frame Frame;
+
+    static constexpr uint8_t PANEL_WIDTH   = Pcd8544Canvas::PANEL_WIDTH;
+    static constexpr uint8_t BANKS         = Pcd8544Canvas::BANKS;
+    static constexpr uint8_t ADDRESS_BYTES = 2;  // Cost of jumping to another column
+
+    explicit Pcd8544Display(Pcd8544Bus &bus) : _bus(bus) { memset(_shown, 0, sizeof(_shown)); }
+
+    void begin(uint8_t contrast = 40, uint8_t bias = 4) {
+        _bus.begin();
+        const uint8_t init [] = {
+            0x21,                      // Function set: extended instructions
+            uint8_t(0x10 | bias),      // Bias system
+            uint8_t(0x80 | contrast),  // Vop
+            0x04,                      // Temperature coefficient 0
+            0x20,                      // Function set: basic instructions, horizontal addressing
+            0x0C,                      // Display control: normal mode
+        };
+        _bus.command(init, sizeof(init));
+
+        // The panel RAM is undefined after reset, so clear it to match _shown
+        const uint8_t home [] = { 0x40, 0x80 };
+        _bus.command(home, sizeof(home));
+        for (uint8_t bank = 0; bank < BANKS; bank++) _bus.data(_shown [bank], PANEL_WIDTH);
+        _addressBank   = 0;
+        _addressColumn = 0;
+    }
+
+    void setContrast(uint8_t contrast) {
+        const uint8_t commands [] = { 0x21, uint8_t(0x80 | (contrast & 0x7F)), 0x20 };
+        _bus.command(commands, sizeof(commands));
+    }
+
+    // Sends the bytes of a complete frame that differ from what the panel shows
+    void display(const Frame &frame) {
+        _lastFrameBytes = 0;
+        for (uint8_t bank = 0; bank < BANKS; bank++) sendChanges(frame, bank);
+        countFrame();
+    }
+
+    // Bytes sent by the last display(), commands included
+    uint32_t lastFrameBytes() const { return _lastFrameBytes; }
+    uint64_t totalBytes() const { return _totalBytes; }
+    uint32_t frames() const { return _frames; }
+
+private:
+    void sendChanges(const Frame &frame, uint8_t bank) {
+        uint8_t column = 0;
+        while (column < PANEL_WIDTH) {
+            if (frame [bank][column] == _shown [bank][column]) {
+                column++;
+                continue;
+            }
+
+            // Extend the run over short unchanged gaps, resending them is cheaper
+            uint8_t start = column, end = column + 1;
+            for (uint8_t next = end; next < PANEL_WIDTH && next - end < ADDRESS_BYTES; next++) {
+                if (frame [bank][next] != _shown [bank][next]) end = next + 1;
+            }
+
+            _lastFrameBytes += sendRun(frame, bank, start, end);
+            column = end;
+        }
+    }
+
+    uint32_t sendRun(const Frame &frame, uint8_t bank, uint8_t start, uint8_t end) {
+        uint32_t bytes = end - start;
+        if (bank != _addressBank || start != _addressColumn) {
+            const uint8_t address [] = { uint8_t(0x40 | bank), uint8_t(0x80 | start) };
+            _bus.command(address, sizeof(address));
+            bytes += sizeof(address);
+        }
+        _bus.data(&frame [bank][start], end - start);
+        memcpy(&_shown [bank][start], &frame [bank][start], end - start);
+
+        // The address counter moves on after every byte and wraps to the next bank
+        _addressBank   = bank;
+        _addressColumn = end;
+        if (_addressColumn == PANEL_WIDTH) {
+            _addressColumn = 0;
+            _addressBank   = (bank + 1) % BANKS;
+        }
+        return bytes;
+    }
+
+    void countFrame() {
+        _totalBytes += _lastFrameBytes;
+        _frames++;
+    }
+
+    Pcd8544Bus &_bus;
+    Frame _shown;  // Image on the panel
+    uint8_t _addressBank   = 0xFF;  // Unknown until the first run
+    uint8_t _addressColumn = 0xFF;
+
+    uint32_t _lastFrameBytes = 0;
+    uint64_t _totalBytes     = 0;
+    uint32_t _frames         = 0;
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Arduino.h>
+#include <driver/gpio.h>
+#include <driver/spi_master.h>
+#include <esp_heap_caps.h>
+
+#include "Pcd8544Display.hpp"
+
+// PCD8544 on a hardware SPI host. Every command or data run is copied into a
+// DMA-capable slot and queued as an asynchronous transaction, so the caller
+// only pays for the copy; the peripheral clocks the bytes out and a pre-
+// transfer callback sets D/C for each transaction. The chip enable line is
+// driven by the peripheral. Transactions finish in order, so a slot is free
+// again once the transaction queued QUEUE_SIZE slots earlier has completed.
+class Pcd8544DmaBus : public Pcd8544Bus {
+public:
+    static constexpr int CLOCK_HZ        = 4000000;  // Fastest serial clock of the PCD8544
+    static constexpr uint8_t QUEUE_SIZE  = 16;       // A full frame is at most 12 transactions
+    static constexpr size_t MAX_TRANSFER = 84;       // One bank, the longest run the display sends
+
+    Pcd8544DmaBus(spi_host_device_t host, int8_t clkPin, int8_t dinPin, int8_t dcPin, int8_t cePin,
+                  int8_t rstPin)
+        : _host(host),
+          _clkPin(clkPin),
+          _dinPin(dinPin),
+          _dcPin(dcPin),
+          _cePin(cePin),
+          _rstPin(rstPin) {}
+
+    void begin() override {
+        pinMode(_dcPin, OUTPUT);
+        pinMode(_rstPin, OUTPUT);
+        digitalWrite(_rstPin, LOW);
+        delay(1);
+        digitalWrite(_rstPin, HIGH);
+
+        spi_bus_config_t bus = {};
+        bus.mosi_io_num      = _dinPin;
+        bus.miso_io_num      = -1;
+        bus.sclk_io_num      = _clkPin;
+        bus.quadwp_io_num    = -1;
+        bus.quadhd_io_num    = -1;
+        bus.max_transfer_sz  = MAX_TRANSFER;
+        ESP_ERROR_CHECK(spi_bus_initialize(_host, &bus, SPI_DMA_CH_AUTO));
+
+        spi_device_interface_config_t device = {};
+        device.clock_speed_hz                = CLOCK_HZ;
+        device.mode                          = 0;
+        device.spics_io_num                  = _cePin;
+        device.queue_size                    = QUEUE_SIZE;
+        device.pre_cb                        = setDataCommand;
+        ESP_ERROR_CHECK(spi_bus_add_device(_host, &device, &_device));
+
+        void *buffers = heap_caps_malloc(QUEUE_SIZE * MAX_TRANSFER, MALLOC_CAP_DMA);
+        ESP_ERROR_CHECK(buffers != nullptr ? ESP_OK : ESP_ERR_NO_MEM);
+        _buffers = static_cast<uint8_t *>(buffers);
+    }
+
+    void command(const uint8_t *bytes, size_t length) override { queue(LOW, bytes, length); }
+    void data(const uint8_t *bytes, size_t length) override { queue(HIGH, bytes, length); }
+
+    // Waits until every queued transaction has been sent
+    void flush() {
+        while (_inFlight > 0) reclaim(portMAX_DELAY);
+    }
+
+    // Times a transaction had to wait for a free slot
+    uint32_t stalls() const { return _stalls; }
+
+private:
+    // Runs in the SPI interrupt just before a transaction starts
+    static void IRAM_ATTR setDataCommand(spi_transaction_t *transaction) {
+        uintptr_t user = reinterpret_cast<uintptr_t>(transaction->user);
+        gpio_set_level(static_cast<gpio_num_t>(user >> 1), user & 1);
+    }
+
+    bool reclaim(TickType_t wait) {
+        spi_transaction_t *done;
+        if (spi_device_get_trans_result(_device, &done, wait) != ESP_OK) return false;
+        _inFlight--;
+        return true;
+    }
+
+    void queue(uint8_t dc, const uint8_t *bytes, size_t length) {
+        while (length > 0) {
+            size_t chunk = length < MAX_TRANSFER ? length : MAX_TRANSFER;
+
+            // Collect finished transactions, and wait only when every slot is in use
+            while (_inFlight > 0 && reclaim(0)) {
+            }
+            if (_inFlight == QUEUE_SIZE) {
+                _stalls++;
+                reclaim(portMAX_DELAY);
+            }
+
+            // setDataCommand() finds the D/C pin and level in the user field
+            uintptr_t dcLevel              = (_dcPin << 1) | dc;
+            spi_transaction_t &transaction = _transactions [_next];
+            transaction                    = {};
+            transaction.length             = chunk * 8;
+            transaction.user               = reinterpret_cast<void *>(dcLevel);
+            if (chunk <= sizeof(transaction.tx_data)) {
+                transaction.flags = SPI_TRANS_USE_TXDATA;  // Short transfers need no DMA buffer
+                memcpy(transaction.tx_data, bytes, chunk);
+            } else {
+                uint8_t *buffer = _buffers + _next * MAX_TRANSFER;
+                memcpy(buffer, bytes, chunk);
+                transaction.tx_buffer = buffer;
+            }
+            spi_device_queue_trans(_device, &transaction, portMAX_DELAY);
+
+            _next = (_next + 1) % QUEUE_SIZE;
+            _inFlight++;
+            bytes += chunk;
+            length -= chunk;
+        }
+    }
+
+    spi_host_device_t _host;
+    int8_t _clkPin;
+    int8_t _dinPin;
+    int8_t _dcPin;
+    int8_t _cePin;
+    int8_t _rstPin;
+
+    spi_device_handle_t _device = nullptr;
+    uint8_t *_buffers           = nullptr;  // QUEUE_SIZE slots of MAX_TRANSFER bytes
+    spi_transaction_t _transactions [QUEUE_SIZE];
+    uint8_t _next     = 0;
+    uint8_t _inFlight = 0;
+    uint32_t _stalls  = 0;
+};
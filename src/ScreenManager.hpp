@@ -0,0 +1,164 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "DisplayRenderer.hpp"
+
+enum class Screen : uint8_t {
+    STATE,
+    INFO,
+    ENTRY,
+    CONNECTING,
+    OFFLINE,
+};
+
+// Stack of screens on the display. The base screen is always there; overlays
+// are pushed on top of it and leave again when their deadline passes, when a
+// key dismisses them or when their owner removes them. Only the top screen is
+// drawn, and only when it changed, from loop(), so nothing here ever waits.
+// Screens are redrawn in full into a frame that the renderer sends to the
+// panel; while the renderer is still busy with the previous frame the redraw
+// waits for a later loop(). Redraw requests only mark the screen dirty, so any
+// number of them between two frames costs one redraw, and frames are at
+// least 1000 / maxFps ms apart.
+class ScreenManager {
+public:
+    static constexpr uint8_t MAX_DEPTH = 6;
+    static constexpr uint32_t FOREVER  = 0;
+    static constexpr uint8_t MAX_FPS   = 20;
+
+    typedef void (*DrawFunction)(Pcd8544Canvas &display, void *context);
+    typedef void (*CloseFunction)(void *context);
+
+    struct Overlay {
+        Screen id;
+        DrawFunction draw;
+        void *context         = nullptr;
+        uint32_t durationMs   = FOREVER;  // Deadline after the overlay was (re)shown
+        bool dismissOnKey     = false;    // The dismissing key is not passed on
+        CloseFunction onClose = nullptr;  // Called when the deadline passes or a key dismisses it
+    };
+
+    explicit ScreenManager(DisplayRenderer &renderer, uint8_t maxFps = MAX_FPS)
+        : _renderer(renderer) {
+        setMaxFps(maxFps);
+    }
+
+    // Frame rate limit, 0 draws every loop() that has something to draw
+    void setMaxFps(uint8_t maxFps) { _frameIntervalMs = maxFps > 0 ? 1000 / maxFps : 0; }
+
+    void setBase(Screen id, DrawFunction draw, void *context = nullptr) {
+        Overlay base;
+        base.id      = id;
+        base.draw    = draw;
+        base.context = context;
+        _stack [0]   = Entry { base, 0 };
+        if (_depth == 0) _depth = 1;
+        requestRedraw();
+    }
+
+    // Shows the overlay on top. An overlay with the same id moves to the top
+    // and its deadline restarts.
+    void show(const Overlay &overlay) {
+        removeFromStack(overlay.id);
+        if (_depth == MAX_DEPTH) removeAt(1);  // Drop the oldest overlay
+        _stack [_depth++] = Entry { overlay, static_cast<uint32_t>(millis()) };
+        requestRedraw();
+    }
+
+    // Removes the overlay without calling onClose
+    void dismiss(Screen id) {
+        if (removeFromStack(id)) requestRedraw();
+    }
+
+    bool isShown(Screen id) const {
+        for (uint8_t i = 0; i < _depth; i++) {
+            if (_stack [i].overlay.id == id) return true;
+        }
+        return false;
+    }
+
+    Screen top() const { return _stack [_depth - 1].overlay.id; }
+
+    // Lets the top overlay consume a key press, true when it did
+    bool keyPressed() {
+        if (_depth <= 1 || !_stack [_depth - 1].overlay.dismissOnKey) return false;
+        close(_depth - 1);
+        return true;
+    }
+
+    // Redraws the top screen on the next loop(), for example after a state change
+    void invalidate() { requestRedraw(); }
+
+    uint32_t redrawsRequested() const { return _requested; }
+    uint32_t framesRendered() const { return _rendered; }
+
+    void loop() {
+        uint32_t now = millis();
+        for (uint8_t i = _depth; i-- > 1;) {
+            const Overlay &overlay = _stack [i].overlay;
+            if (overlay.durationMs == FOREVER || now - _stack [i].shownAt < overlay.durationMs) {
+                continue;
+            }
+            close(i);
+        }
+
+        if (!_dirty || _depth == 0 || now - _lastFrameAt < _frameIntervalMs) return;
+        Pcd8544Canvas *canvas = _renderer.beginFrame();
+        if (canvas == nullptr) return;
+
+        _dirty       = false;
+        _lastFrameAt = now;
+        _rendered++;
+        const Overlay &visible = _stack [_depth - 1].overlay;
+        canvas->clearDisplay();
+        canvas->setTextSize(1);
+        canvas->setTextColor(BLACK);
+        canvas->setCursor(0, 0);
+        visible.draw(*canvas, visible.context);
+        _renderer.submitFrame();
+    }
+
+private:
+    struct Entry {
+        Overlay overlay;
+        uint32_t shownAt;
+    };
+
+    void close(uint8_t index) {
+        CloseFunction onClose = _stack [index].overlay.onClose;
+        void *context         = _stack [index].overlay.context;
+        removeAt(index);
+        requestRedraw();
+        if (onClose != nullptr) onClose(context);  // May show another overlay
+    }
+
+    void requestRedraw() {
+        _dirty = true;
+        _requested++;
+    }
+
+    bool removeFromStack(Screen id) {
+        for (uint8_t i = 1; i < _depth; i++) {
+            if (_stack [i].overlay.id == id) {
+                removeAt(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void removeAt(uint8_t index) {
+        for (uint8_t i = index; i + 1 < _depth; i++) _stack [i] = _stack [i + 1];
+        _depth--;
+    }
+
+    DisplayRenderer &_renderer;
+    Entry _stack [MAX_DEPTH];
+    uint8_t _depth            = 0;
+    bool _dirty               = false;
+    uint32_t _frameIntervalMs = 0;
+    uint32_t _lastFrameAt     = 0;
+    uint32_t _requested       = 0;
+    uint32_t _rendered        = 0;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// SipHash-2-4: a keyed 64-bit hash. With a secret key the digest of a short
+// input cannot be predicted or forced into collisions from outside.
+class SipHash {
+public:
+    static uint64_t hash(const uint8_t key [16], const uint8_t *data, size_t length) {
+        uint64_t k0 = read64(key), k1 = read64(key + 8);
+        uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+        uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+        uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+        uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+
+        size_t blocks = length & ~size_t(7);
+        for (size_t i = 0; i < blocks; i += 8) {
+            uint64_t m = read64(data + i);
+            v3 ^= m;
+            round(v0, v1, v2, v3);
+            round(v0, v1, v2, v3);
+            v0 ^= m;
+        }
+
+        uint64_t last = uint64_t(length) << 56;
+        for (size_t i = blocks; i < length; i++) last |= uint64_t(data [i]) << (8 * (i - blocks));
+        v3 ^= last;
+        round(v0, v1, v2, v3);
+        round(v0, v1, v2, v3);
+        v0 ^= last;
+
+        v2 ^= 0xff;
+        for (int i = 0; i < 4; i++) round(v0, v1, v2, v3);
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int b) { return (x << b) | (x >> (64 - b)); }
+
+    static uint64_t read64(const uint8_t *p) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; i--) value = (value << 8) | p [i];
+        return value;
+    }
+
+    static void round(uint64_t &v0, uint64_t &v1, uint64_t &v2, uint64_t &v3) {
+        v0 += v1;
+        v1 = rotl(v1, 13);
+        v1 ^= v0;
+        v0 = rotl(v0, 32);
+        v2 += v3;
+        v3 = rotl(v3, 16);
+        v3 ^= v2;
+        v0 += v3;
+        v3 = rotl(v3, 21);
+        v3 ^= v0;
+        v2 += v1;
+        v1 = rotl(v1, 17);
+        v1 ^= v2;
+        v2 = rotl(v2, 32);
+    }
+};
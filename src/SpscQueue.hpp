@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity ring buffer for exactly one producer and one consumer (for
+// example a FreeRTOS task and loop()). No locks, no heap: the producer only
+// writes head, the consumer only writes tail. Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer side. Returns false (and counts an overflow) when the queue is full.
+    bool push(const T &item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= Capacity) {
+            _overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _items [head & (Capacity - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when the queue is empty.
+    bool pop(T &item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _items [tail & (Capacity - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    uint32_t overflows() const { return _overflows.load(std::memory_order_relaxed); }
+
+private:
+    T _items [Capacity];
+    std::atomic<uint32_t> _head { 0 };
+    std::atomic<uint32_t> _tail { 0 };
+    std::atomic<uint32_t> _overflows { 0 };
+};
@@ -3,6 +3,9 @@
 #include "AlarmState.hpp"
 #include "LED.hpp"
 
+// Red, orange and green state LEDs. setState() only records the wanted state;
+// loop() applies it once, and only when it differs from what the LEDs show,
+// so repeated updates neither print again nor restart the flashing.
 class StatusLEDs {
 public:
     StatusLEDs() : redLED(RED_LED_PIN), orangeLED(ORANGE_LED_PIN), greenLED(GREEN_LED_PIN) {}
@@ -14,6 +17,40 @@ public:
     }
 
     void setState(AlarmState state, bool acknowledged) {
+        wantedState        = state;
+        wantedAcknowledged = acknowledged;
+        pending            = true;
+    }
+
+    void setBrightness(int brightness) {
+        redLED.setBrightness(brightness);
+        orangeLED.setBrightness(brightness);
+        greenLED.setBrightness(brightness);
+    }
+
+    void loop() {
+        if (pending) {
+            pending = false;
+            if (!shown || wantedState != shownState || wantedAcknowledged != shownAcknowledged) {
+                show(wantedState, wantedAcknowledged);
+            }
+        }
+
+        redLED.loop();
+        orangeLED.loop();
+        greenLED.loop();
+    }
+
+private:
+    static constexpr int RED_LED_PIN    = 32;
+    static constexpr int ORANGE_LED_PIN = 4;
+    static constexpr int GREEN_LED_PIN  = 5;
+
+    void show(AlarmState state, bool acknowledged) {
+        shown             = true;
+        shownState        = state;
+        shownAcknowledged = acknowledged;
+
         redLED.off();
         orangeLED.off();
         greenLED.off();
@@ -34,24 +71,14 @@ public:
         greenLED.on(!acknowledged);
     }
 
-    void setBrightness(int brightness) {
-        redLED.setBrightness(brightness);
-        orangeLED.setBrightness(brightness);
-        greenLED.setBrightness(brightness);
-    }
-
-    void loop() {
-        redLED.loop();
-        orangeLED.loop();
-        greenLED.loop();
-    }
-
-private:
-    static constexpr int RED_LED_PIN    = 32;
-    static constexpr int ORANGE_LED_PIN = 4;
-    static constexpr int GREEN_LED_PIN  = 5;
-
     LED redLED;
     LED orangeLED;
     LED greenLED;
+
+    AlarmState wantedState  = AlarmState::HOME;
+    AlarmState shownState   = AlarmState::HOME;
+    bool wantedAcknowledged = false;
+    bool shownAcknowledged  = false;
+    bool pending            = false;
+    bool shown              = false;  // Nothing applied yet
 };
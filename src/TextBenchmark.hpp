@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+
+#include "Pcd8544Display.hpp"
+
+// Times the ways text reaches the framebuffer: Adafruit GFX print(), which
+// sets one pixel at a time, against Pcd8544Canvas::drawText() at a bank
+// aligned and at a shifted row. Runs on a scratch canvas, so it can be called
+// from any task without disturbing the screen.
+//
+// start() runs it in a task of its own, so a web server callback does not hold
+// up the AsyncTCP task for the whole run; last() reports it once it is done.
+// Call start() and last() from one task.
+class TextBenchmark {
+public:
+    static constexpr const char *SAMPLE   = "192.168.100.20";  // Longest line of the info screen
+    static constexpr uint32_t STACK_SIZE  = 4096;
+    static constexpr UBaseType_t PRIORITY = 1;  // Only the idle task runs below it
+    static constexpr BaseType_t CORE      = 0;  // Away from loop() and the keypad on core 1
+
+    struct Result {
+        uint16_t iterations;
+        float gfxMicros;      // Per line
+        float alignedMicros;  // Per line
+        float shiftedMicros;  // Per line
+    };
+
+    static Result run(uint16_t iterations) {
+        static Pcd8544Canvas::Frame frame;
+        static Pcd8544Canvas scratch(frame);
+        size_t length = strlen(SAMPLE);
+
+        Result result;
+        result.iterations = iterations;
+
+        scratch.setTextSize(1);
+        scratch.setTextColor(BLACK, WHITE);
+        scratch.setTextWrap(false);
+        uint32_t start = micros();
+        for (uint16_t i = 0; i < iterations; i++) {
+            scratch.setCursor(0, 16);
+            scratch.print(SAMPLE);
+        }
+        result.gfxMicros = float(micros() - start) / iterations;
+
+        start = micros();
+        for (uint16_t i = 0; i < iterations; i++) scratch.drawText(0, 16, SAMPLE, length);
+        result.alignedMicros = float(micros() - start) / iterations;
+
+        start = micros();
+        for (uint16_t i = 0; i < iterations; i++) scratch.drawText(0, 19, SAMPLE, length);
+        result.shiftedMicros = float(micros() - start) / iterations;
+
+        return result;
+    }
+
+    // Starts run() in its own task, false while an earlier run is still going
+    bool start(uint16_t iterations) {
+        if (_running.exchange(true, std::memory_order_acquire)) return false;
+        _iterations = iterations;
+        if (xTaskCreatePinnedToCore(taskEntry, "benchmark", STACK_SIZE, this, PRIORITY, nullptr,
+                                    CORE) != pdPASS) {
+            _running.store(false, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    // Result of the last finished run, false when none has finished or one is going
+    bool last(Result &result) const {
+        if (_running.load(std::memory_order_acquire) || _last.iterations == 0) return false;
+        result = _last;
+        return true;
+    }
+
+private:
+    static void taskEntry(void *arg) {
+        TextBenchmark *benchmark = static_cast<TextBenchmark *>(arg);
+        benchmark->_last         = run(benchmark->_iterations);
+        benchmark->_running.store(false, std::memory_order_release);
+        vTaskDelete(nullptr);
+    }
+
+    uint16_t _iterations = 0;
+    Result _last         = {};
+    std::atomic<bool> _running { false };
+};
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <time.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "CommandParser.hpp"
+#include "SipHash.hpp"
+
+// Access code of one person, stored in NVS. The code itself is not kept, only
+// its SipHash under a random per-device key.
+struct UserCode {
+    static constexpr size_t LABEL_SIZE  = 16;
+    static constexpr size_t MAX_ALLOWED = 6;
+
+    uint64_t digest;
+    char label [LABEL_SIZE];              // Passed along with Homey triggers
+    uint32_t validFrom;                   // Unix time, 0 for no start
+    uint32_t validUntil;                  // Unix time, 0 for no end
+    int32_t allowedCommands [MAX_ALLOWED];
+    uint8_t allowedCount;                 // 0 allows every command
+
+    bool allows(int32_t command) const {
+        if (allowedCount == 0) return true;
+        for (uint8_t i = 0; i < allowedCount && i < MAX_ALLOWED; i++) {
+            if (allowedCommands [i] == command) return true;
+        }
+        return false;
+    }
+
+    // Codes with a validity window are refused while the clock is not set
+    bool validAt(time_t now, bool clockSet) const {
+        if (validFrom == 0 && validUntil == 0) return true;
+        if (!clockSet) return false;
+        return (validFrom == 0 || now >= (time_t)validFrom) &&
+               (validUntil == 0 || now < (time_t)validUntil);
+    }
+};
+
+// Immutable snapshot of the user codes, indexed by digest with open addressing
+class UserCodeSet {
+public:
+    UserCodeSet(const UserCode *codes, size_t count) : _codes(new UserCode [count]) {
+        memcpy(_codes.get(), codes, count * sizeof(UserCode));
+
+        size_t slots = 8;
+        while (slots < count * 2) slots <<= 1;  // Keep the load factor at or below one half
+        _mask = slots - 1;
+        _index.reset(new uint16_t [slots]);
+        for (size_t slot = 0; slot < slots; slot++) _index [slot] = EMPTY;
+
+        for (size_t i = 0; i < count; i++) {
+            size_t slot = codes [i].digest & _mask;
+            while (_index [slot] != EMPTY) slot = (slot + 1) & _mask;
+            _index [slot] = i;
+        }
+    }
+
+    // Digests are compared as whole words, so the time taken does not depend on
+    // how many leading bytes of a code match
+    const UserCode *find(uint64_t digest) const {
+        for (size_t slot = digest & _mask;; slot = (slot + 1) & _mask) {
+            uint16_t i = _index [slot];
+            if (i == EMPTY) return nullptr;
+            if (_codes [i].digest == digest) return &_codes [i];
+        }
+    }
+
+private:
+    static constexpr uint16_t EMPTY = 0xFFFF;
+
+    std::unique_ptr<UserCode []> _codes;
+    std::unique_ptr<uint16_t []> _index;
+    size_t _mask;
+};
+
+// User codes, edited from the web server and the keypad and verified from
+// loop(). Edits are stored and published the same way as CustomCommands: an
+// edit is adopted only once NVS holds it, and loop() picks up the newest
+// snapshot in apply(), so a lookup never sees a half-applied edit.
+//
+// The table is one NVS blob of MAX_USERS * 64 bytes (4 KB), next to the
+// command table in the 20 KB nvs partition; see CustomCommands for the budget.
+class UserCodes {
+public:
+    static constexpr size_t MAX_USERS = 64;
+    static constexpr time_t CLOCK_SET = 1700000000;  // Earlier times mean SNTP has not synced yet
+
+    enum Result {
+        OK,
+        FULL,            // MAX_USERS reached
+        DUPLICATE_CODE,  // Another label already has this code
+        NOT_FOUND,
+        NOT_SAVED,       // Could not be written to NVS, nothing changed
+        NO_KEY,          // The SipHash key is not in NVS, so no code can be stored
+    };
+
+    ~UserCodes() { delete _pending.exchange(nullptr); }
+
+    void begin() {
+        _preferences.begin("users", false);
+
+        // A new key would make every stored digest unverifiable, so it is only
+        // generated while there is no table
+        if (_preferences.getBytes("key", _key, sizeof(_key)) == sizeof(_key)) {
+            _keyStored = true;
+        } else if (_preferences.isKey("table")) {
+            Serial.println("User code key unreadable, user codes cannot be changed");
+        } else {
+            for (size_t i = 0; i < sizeof(_key); i += 4) {
+                uint32_t random = esp_random();
+                memcpy(_key + i, &random, 4);
+            }
+            _keyStored = _preferences.putBytes("key", _key, sizeof(_key)) == sizeof(_key);
+            if (!_keyStored) Serial.println("User code key not saved, codes cannot be changed");
+        }
+
+        size_t length = _preferences.getBytesLength("table");
+        if (length > 0 && length % sizeof(UserCode) == 0) {
+            _entries.resize(length / sizeof(UserCode));
+            _preferences.getBytes("table", _entries.data(), length);
+        }
+        _active.reset(new UserCodeSet(_entries.data(), _entries.size()));
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.empty();
+    }
+
+    // Set once the code of earlier firmware has been taken over, or refused
+    bool migrated() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _preferences.getBool("migrated", false);
+    }
+
+    void setMigrated() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _preferences.putBool("migrated", true);
+    }
+
+    // Digest of a code as entered. The code is padded to the keypad buffer
+    // size, so hashing takes the same time for every code length.
+    uint64_t digest(TextView code) const {
+        uint8_t padded [CommandBuffer::CAPACITY + 1] = {};
+        size_t length = code.length < CommandBuffer::CAPACITY ? code.length
+                                                              : CommandBuffer::CAPACITY;
+        memcpy(padded, code.data, length);
+        padded [CommandBuffer::CAPACITY] = length;
+        return SipHash::hash(_key, padded, sizeof(padded));
+    }
+
+    // Adopts the latest edit, call from loop() only
+    void apply() {
+        UserCodeSet *pending = _pending.exchange(nullptr, std::memory_order_acquire);
+        if (pending != nullptr) _active.reset(pending);
+    }
+
+    // User with this code, valid right now. Call from loop() only.
+    const UserCode *verify(TextView code) const {
+        const UserCode *user = _active->find(digest(code));
+        time_t now           = time(nullptr);
+        if (user == nullptr || !user->validAt(now, now >= CLOCK_SET)) return nullptr;
+        return user;
+    }
+
+    // Adds the user, or replaces the one with the same label
+    Result put(const UserCode &user) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<UserCode> entries = _entries;
+        UserCode *existing            = nullptr;
+        for (UserCode &entry : entries) {
+            if (strcmp(entry.label, user.label) == 0) {
+                existing = &entry;
+            } else if (entry.digest == user.digest) {
+                return DUPLICATE_CODE;
+            }
+        }
+
+        if (existing != nullptr) {
+            *existing = user;
+        } else if (entries.size() >= MAX_USERS) {
+            return FULL;
+        } else {
+            entries.push_back(user);
+        }
+        return publish(std::move(entries));
+    }
+
+    // Copy of the user with this label, false when there is none
+    bool get(const char *label, UserCode &user) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const UserCode &entry : _entries) {
+            if (strcmp(entry.label, label) == 0) {
+                user = entry;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Result remove(const char *label) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (size_t i = 0; i < _entries.size(); i++) {
+            if (strcmp(_entries [i].label, label) == 0) {
+                std::vector<UserCode> entries = _entries;
+                entries.erase(entries.begin() + i);
+                return publish(std::move(entries));
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    // One "<label> <valid from> <valid until> <allowed commands>" line per user,
+    // the allowed commands comma separated or "*" for all. Codes are never shown.
+    void print(Print &out) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const UserCode &entry : _entries) {
+            out.printf("%s %lu %lu ", entry.label, (unsigned long)entry.validFrom,
+                       (unsigned long)entry.validUntil);
+            if (entry.allowedCount == 0) out.print('*');
+            for (uint8_t i = 0; i < entry.allowedCount; i++) {
+                out.printf(i == 0 ? "%ld" : ",%ld", (long)entry.allowedCommands [i]);
+            }
+            out.println();
+        }
+    }
+
+private:
+    // Stores the edited table and adopts it, NOT_SAVED and unchanged when NVS refuses it
+    Result publish(std::vector<UserCode> entries) {
+        if (!_keyStored) return NO_KEY;
+
+        // putBytes() refuses an empty blob, so the last removal deletes the key
+        size_t length = entries.size() * sizeof(UserCode);
+        bool stored   = entries.empty()
+                            ? _preferences.remove("table")
+                            : _preferences.putBytes("table", entries.data(), length) == length;
+        if (!stored) return NOT_SAVED;
+
+        _entries          = std::move(entries);
+        UserCodeSet *next = new UserCodeSet(_entries.data(), _entries.size());
+        delete _pending.exchange(next, std::memory_order_release);  // Never adopted by loop()
+        return OK;
+    }
+
+    Preferences _preferences;
+    uint8_t _key [16] = {};                           // SipHash key, generated on first boot
+    bool _keyStored   = false;                        // _key is the one in NVS
+    std::mutex _mutex;                                // Serializes edits of _entries
+    std::vector<UserCode> _entries;                   // Source of truth, as stored in NVS
+    std::unique_ptr<UserCodeSet> _active;             // Used by loop()
+    std::atomic<UserCodeSet *> _pending { nullptr };  // Published, not yet adopted
+};
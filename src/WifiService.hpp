@@ -3,42 +3,80 @@
 #include <Arduino.h>
 #include <WiFi.h>
 
-#include "Adafruit_PCD8544.h"
+#include "Banner.hpp"
+#include "ScreenManager.hpp"
 #include "wifi_config.h"
 
+// Connects in the background: begin() starts the connection and loop() follows
+// its progress, with a "connecting" overlay until the first connection and an
+// "offline" overlay whenever it drops later on.
 class WifiService {
 public:
-    WifiService(const String &deviceName, Adafruit_PCD8544 &displayRef)
-        : deviceName(deviceName), display(displayRef) {}
+    static constexpr uint32_t PROGRESS_INTERVAL_MS = 500;
 
-    void connect() {
+    WifiService(const String &deviceName, ScreenManager &screens)
+        : deviceName(deviceName), screens(screens) {}
+
+    void begin() {
         WiFiClass::setHostname(deviceName.c_str());
+        WiFi.setAutoReconnect(true);
         WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
 
-        display.clearDisplay();
-        display.setTextSize(1);
-        display.setTextColor(BLACK);
-        display.setCursor(0, 0);
-
         Serial.print("Connecting WiFi");
-        display.print("Connecting");
-        display.display();
+        ScreenManager::Overlay connecting;
+        connecting.id      = Screen::CONNECTING;
+        connecting.draw    = drawProgress;
+        connecting.context = this;
+        screens.show(connecting);
+        lastProgress = millis();
+    }
+
+    void loop() {
+        bool isConnected = WiFiClass::status() == WL_CONNECTED;
+
+        if (isConnected && !connected) {
+            connected = true;
+            screens.dismiss(Screen::CONNECTING);
+            screens.dismiss(Screen::OFFLINE);
+
+            String ipStr = WiFi.localIP().toString();
+            Serial.print("\nConnected. IP address: ");
+            Serial.println(ipStr);
+        } else if (!isConnected && connected) {
+            connected = false;
+            Serial.print("WiFi connection lost, reconnecting");
 
-        while (WiFiClass::status() != WL_CONNECTED) {
-            delay(500);
+            ScreenManager::Overlay offline;
+            offline.id      = Screen::OFFLINE;
+            offline.draw    = drawProgress;
+            offline.context = this;
+            screens.show(offline);
+        }
+
+        if (!connected && millis() - lastProgress >= PROGRESS_INTERVAL_MS) {
+            lastProgress = millis();
+            progress++;
             Serial.print(".");
-            display.print(".");
-            display.display();
+            screens.invalidate();
         }
+    }
 
-        IPAddress ip = WiFi.localIP();
-        String ipStr = ip.toString();
+    bool isConnected() const { return connected; }
 
-        Serial.print("\nConnected. IP address: ");
-        Serial.println(ipStr);
+private:
+    static void drawProgress(Pcd8544Canvas &display, void *context) {
+        static constexpr Banner connecting = Banner::render("Connecting", Banner::LEFT);
+        static constexpr Banner offline    = Banner::render("WiFi offline", Banner::LEFT);
+
+        WifiService *service = static_cast<WifiService *>(context);
+        display.drawBank(0, service->screens.top() == Screen::OFFLINE ? offline.columns
+                                                                      : connecting.columns);
+        display.drawText(0, 8, "..............", service->progress % 14);
     }
 
-private:
     String deviceName;
-    Adafruit_PCD8544 &display;
+    ScreenManager &screens;
+    bool connected        = false;
+    uint32_t lastProgress = 0;
+    uint8_t progress      = 0;
 };
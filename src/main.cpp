@@ -2,21 +2,33 @@
  * Homey Alarm Keypad
  */
 
-#include <Adafruit_PCD8544.h>
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
 #include <ElegantOTA.h>
 #include <Homey.h>
-#include <Keypad.h>
 #include <Preferences.h>
 
 #include <map>
 
+#include "AssetPartition.hpp"
+#include "AudioSequencer.hpp"
 #include "Backlight.hpp"
+#include "Banner.hpp"
+#include "CommandParser.hpp"
+#include "CommandTable.hpp"
+#include "CustomCommands.hpp"
+#include "DisplayRenderer.hpp"
 #include "HardwareSerial.h"
+#include "MatrixKeypad.hpp"
+#include "MelodyStream.hpp"
+#include "Pcd8544Display.hpp"
+#include "Pcd8544DmaBus.hpp"
+#include "ScreenManager.hpp"
 #include "States.h"
 #include "StatusLEDs.hpp"
+#include "TextBenchmark.hpp"
 #include "UptimeFormatter.hpp"
+#include "UserCodes.hpp"
 #include "WifiService.hpp"
 #include "config.h"
 #include "easteregg.hpp"
@@ -30,11 +42,11 @@ StatusLEDs statusLEDs;
 uint8_t state          = 0;
 bool stateAcknowledged = false;
 
-const uint8_t KEYBOARD_ENTRY_ROW    = 35;
+const uint8_t KEYBOARD_ENTRY_ROW    = 32;  // Bank aligned, see Pcd8544Canvas::drawText()
 const uint8_t KEYBOARD_ENTRY_COLUMN = 0;
 
-uint8_t display_x = KEYBOARD_ENTRY_COLUMN;
-uint8_t display_y = KEYBOARD_ENTRY_ROW;
+const uint32_t INFO_SCREEN_MS   = 5000;
+const uint32_t ENTRY_TIMEOUT_MS = 30000;  // An unfinished entry is abandoned after this
 
 bool shouldHideKeyboardEntry = true;
 
@@ -51,28 +63,64 @@ char keys [ROWS][COLS] = {
 #ifdef KEYPAD_1
 byte rowPins [ROWS] = { 13, 12, 14, 27 };
 byte colPins [COLS] = { 26, 25, 33 };
+// Membrane contacts barely bounce, a short integration only rejects noise
+const MatrixKeypad::Debounce keypadDebounce = { 1, 3 };
 #elif defined(KEYPAD_2)
 byte rowPins [ROWS] = { 12, 33, 25, 27 };
 byte colPins [COLS] = { 14, 13, 26 };
+// Mechanical buttons bounce for several milliseconds on press and release
+const MatrixKeypad::Debounce keypadDebounce = { 1, 8 };
 #endif
 
-Keypad keypad = Keypad(makeKeymap(keys), rowPins, colPins, ROWS, COLS);
-Preferences preferences;
+MatrixKeypad keypad(&keys [0][0], rowPins, colPins, ROWS, COLS, keypadDebounce);
 
-String pinCode        = "0000";  // Default PIN code stored in flash memory
-String currentCommand = "";
+CommandBuffer currentCommand;
+AssetPartition assets;
+CustomCommands customCommands;
+TextBenchmark textBenchmark;
+UserCodes userCodes;
+const UserCode *currentUser = nullptr;  // Whose code is running, nullptr outside keypad commands
 
-const int BUZZER_PIN = 15;
+const int BUZZER_PIN         = 15;
+const uint8_t BUZZER_CHANNEL = 0;  // analogWrite() takes LEDC channels from the top down
+
+AudioSequencer audio(BUZZER_PIN, BUZZER_CHANNEL);
+
+constexpr Note clickNotes []   = { { NOTE_B3, 50 } };
+constexpr Note successNotes [] = {
+    { NOTE_C5, 100 },
+    { NOTE_D5, 100 },
+    { NOTE_F5, 100 },
+    { NOTE_G5, 100 }
+};
+constexpr Note acknowledgeNotes [] = {
+    { NOTE_G5, 150 },
+    { NOTE_F5, 200 }
+};
+constexpr Note errorNotes [] = { { NOTE_A2, 500 } };
+
+const NoteList clickMelody(clickNotes);
+const NoteList successMelody(successNotes);
+const NoteList acknowledgeMelody(acknowledgeNotes);
+const NoteList errorMelody(errorNotes);
+const MelodyStream monkeyIslandTune(MonkeyIslandTheme::FREQUENCIES, MonkeyIslandTheme::NOTES);
 
 // Pin configuration for Nokia 5110 display
 #define RST_PIN 16  // Reset
 #define CE_PIN  17  // Chip Enable
 #define DC_PIN  2   // Data/Command
-#define DIN_PIN 23  // Data In (MOSI)
-#define CLK_PIN 18  // Clock
+#define DIN_PIN 23  // Data In (VSPI MOSI)
+#define CLK_PIN 18  // Clock (VSPI SCK)
 #define BL_PIN  22  // Backlight
 
-Adafruit_PCD8544 display = Adafruit_PCD8544(CLK_PIN, DIN_PIN, DC_PIN, CE_PIN, RST_PIN);
+Pcd8544DmaBus displayBus(VSPI_HOST, CLK_PIN, DIN_PIN, DC_PIN, CE_PIN, RST_PIN);
+Pcd8544Display display(displayBus);
+DisplayRenderer renderer(display);
+ScreenManager screens(renderer);
+
+// Keys shown on the entry screen, '*' for the hidden ones
+char entryText [CommandBuffer::CAPACITY + 1];
+size_t entryLength = 0;
 
 LED backlightLed(BL_PIN);
 Backlight backlight(backlightLed);
@@ -84,7 +132,7 @@ struct KeyValue {
     const char *value;
 };
 
-struct KeyValue stateTexts [] = {
+constexpr KeyValue stateTexts [] = {
     { HOME,     "THUIS"    },
     { AWAY,     "AFWEZIG"  },
     { SLEEP,    "SLAPEN"   },
@@ -93,14 +141,30 @@ struct KeyValue stateTexts [] = {
     { DISARMED, "DISARMED" }
 };
 
+// The state texts pre-rendered into display banks, indexed by state
+constexpr int MAX_STATE      = DISARMED;
+constexpr uint8_t STATE_BANK = 2;
+
+struct StateBanners {
+    Banner banners [MAX_STATE + 1];
+    Banner error;
+
+    constexpr StateBanners() : banners {}, error(Banner::render("ERROR")) {
+        for (Banner &banner : banners) banner = error;
+        for (const KeyValue &text : stateTexts) banners [text.key] = Banner::render(text.value);
+    }
+};
+
+constexpr StateBanners stateBanners;
+
 // Lookup table for string-to-numeric state mapping
-const std::map<String, int> eufyStateMapping = {
-    { "home",     HOME     },
-    { "away",     AWAY     },
-    { "custom_1", SLEEP    },
-    { "custom_2", ALERT    },
-    { "schedule", SCHEDULE },
-    { "disarmed", DISARMED }
+struct KeyValue eufyStateMapping [] = {
+    { HOME,     "home"     },
+    { AWAY,     "away"     },
+    { SLEEP,    "custom_1" },
+    { ALERT,    "custom_2" },
+    { SCHEDULE, "schedule" },
+    { DISARMED, "disarmed" }
 };
 
 // Lookup table for state-to-trigger mapping
@@ -113,16 +177,20 @@ const std::map<int, String> stateTriggerMapping = {
 };
 
 // Function prototypes
-void setState();
+void setState(int newState);
 void getState();
 void applyState();
 void displayState();
-void handleEufyStateChange();
+void drawState(Pcd8544Canvas &display, void *);
+void drawEntry(Pcd8544Canvas &display, void *);
+void drawInfo(Pcd8544Canvas &display, void *);
+void abandonEntry(void *);
+void handleEufyStateChange(HomeyStringView eufyState);
 void beep();
+void handleKey(char key);
 void displayKeyboardEntry(char c);
 void clearKeyboardEntry();
-void parseCommand(const String &command);
-void savePinCodeToFlash(String &newPinCode);
+void parseCommand(TextView entry);
 void playSuccessNotes();
 void playAcknowledgeNotes();
 void playErrorNotes();
@@ -130,14 +198,19 @@ void triggerHomey();
 void requestAlarmStateFromHomey();
 void displayLEDState();
 
-int mapEufyState(const String &state);
+int mapEufyState(HomeyStringView state);
 
 void changeAlarmState(int newState, const char *message);
-void handlePinChange(const String &command);
+void handlePinChange(TextView newPin);
 void playMonkeyIslandTheme();
+void releaseAssets();
 void displayInfo();
 void invalidCommand();
-void executeCommand(int commandValue, const String &command);
+void executeCommand(int commandValue, const ParsedCommand &command);
+void addCommandRoutes();
+void addUserRoutes();
+void addAssetRoutes();
+void migrateOwnerCode();
 
 constexpr int CMD_HOME       = 0;
 constexpr int CMD_AWAY       = 1;
@@ -150,17 +223,32 @@ constexpr int CMD_REBOOT     = 88;
 constexpr int CMD_CHANGE_PIN = 99;
 constexpr int CMD_EASTER_EGG = 1990;
 
-// Lookup table for command handlers
-const std::map<int, std::function<void()>> commandHandlers = {
-    { CMD_HOME,       []() { changeAlarmState(HOME, "Turning off the alarm"); }                   },
-    { CMD_AWAY,       []() { changeAlarmState(AWAY, "Putting the alarm in away mode"); }          },
-    { CMD_SLEEP,      []() { changeAlarmState(SLEEP, "Putting the alarm into sleep mode"); }      },
-    { CMD_ALERT,      []() { changeAlarmState(ALERT, "Putting the alarm into alert mode"); }      },
-    { CMD_SCHEDULE,   []() { changeAlarmState(SCHEDULE, "Putting the alarm on scheduled mode"); } },
-    { CMD_REBOOT,     esp_restart                                                                 },
-    { CMD_INFO,       displayInfo                                                                 },
-    { CMD_EASTER_EGG, playMonkeyIslandTheme                                                       }
+// Command handlers, the argument is empty unless the command takes one
+void homeCommand(TextView) { changeAlarmState(HOME, "Turning off the alarm"); }
+void awayCommand(TextView) { changeAlarmState(AWAY, "Putting the alarm in away mode"); }
+void sleepCommand(TextView) { changeAlarmState(SLEEP, "Putting the alarm into sleep mode"); }
+void alertCommand(TextView) { changeAlarmState(ALERT, "Putting the alarm into alert mode"); }
+void scheduleCommand(TextView) {
+    changeAlarmState(SCHEDULE, "Putting the alarm on scheduled mode");
+}
+void infoCommand(TextView) { displayInfo(); }
+void rebootCommand(TextView) { esp_restart(); }
+void easterEggCommand(TextView) { playMonkeyIslandTheme(); }
+
+// Command table, sorted by code and kept in flash
+constexpr Command commands [] = {
+    { CMD_HOME,       homeCommand,      false },
+    { CMD_AWAY,       awayCommand,      false },
+    { CMD_SLEEP,      sleepCommand,     false },
+    { CMD_ALERT,      alertCommand,     false },
+    { CMD_SCHEDULE,   scheduleCommand,  false },
+    { CMD_INFO,       infoCommand,      false },
+    { CMD_REBOOT,     rebootCommand,    false },
+    { CMD_CHANGE_PIN, handlePinChange,  true  },
+    { CMD_EASTER_EGG, easterEggCommand, false }
 };
+static_assert(CommandTable::isSortedAndUnique(commands),
+              "commands must be sorted by code and every code must be unique");
 
 void setup() {
     String deviceName = "keypad-" + String(ESP.getEfuseMac());
@@ -168,45 +256,82 @@ void setup() {
     Serial.begin(115200);
     display.begin();
     display.setContrast(60);
+    renderer.begin();  // From here on only the render task talks to the display
 
     backlightLed.setBrightness(8);
     backlight.begin();
 
-    wifiService = new WifiService(deviceName, display);
-    wifiService->connect();
+    screens.setBase(Screen::STATE, drawState);
+
+    wifiService = new WifiService(deviceName, screens);
+    wifiService->begin();
+    configTime(0, 0, "pool.ntp.org");  // Validity windows of user codes are in UTC
 
     server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
         String responseMessage = "Keypad is online!\n\n";
         responseMessage += "Build Date: " + String(__DATE__) + "\n";
         responseMessage += "Build Time: " + String(__TIME__) + "\n\n";
 
-        responseMessage += "Uptime: " + UptimeFormatter::getUptime();
+        responseMessage += "Uptime: " + UptimeFormatter::getUptime() + "\n";
+        responseMessage += "Keys dropped: " + String(keypad.overflows()) + "\n";
+        responseMessage += "Late keypad scans: " + String(keypad.lateScans()) + "\n";
+        responseMessage += "Display bytes last frame: " + String(display.lastFrameBytes()) + "\n";
+        responseMessage += "Display frames: " + String(display.frames()) + ", ";
+        responseMessage += String((unsigned long long)display.totalBytes()) + " bytes\n";
+        responseMessage += "Display queue stalls: " + String(displayBus.stalls()) + "\n";
+        responseMessage += "Frames submitted: " + String(renderer.framesSubmitted()) + ", ";
+        responseMessage += "pushed: " + String(renderer.framesPushed()) + "\n";
+        responseMessage += "Redraws requested: " + String(screens.redrawsRequested()) + ", ";
+        responseMessage += "rendered: " + String(screens.framesRendered());
+
+        request->send(200, "text/plain", responseMessage);
+    });
 
+    // Starts a run and answers with the previous one, so a second request has the numbers
+    server.on("/benchmark/text", HTTP_GET, [](AsyncWebServerRequest *request) {
+        TextBenchmark::Result result;
+        bool finished          = textBenchmark.last(result);
+        bool started           = textBenchmark.start(500);
+        String responseMessage = started ? "Benchmark started\n" : "Benchmark running\n";
+        if (!finished) {
+            request->send(202, "text/plain", responseMessage + "Request again for the result\n");
+            return;
+        }
+        responseMessage += "Microseconds per line of text, last run of ";
+        responseMessage += String(result.iterations) + "\n";
+        responseMessage += "Adafruit GFX print: " + String(result.gfxMicros, 2) + "\n";
+        responseMessage += "drawText, bank aligned: " + String(result.alignedMicros, 2) + "\n";
+        responseMessage += "drawText, shifted: " + String(result.shiftedMicros, 2) + "\n";
         request->send(200, "text/plain", responseMessage);
     });
 
+    assets.begin();
+    customCommands.begin();
+    userCodes.begin();
+    migrateOwnerCode();
+
+    addCommandRoutes();
+    addUserRoutes();
+    addAssetRoutes();
     ElegantOTA.begin(&server);
     server.begin();
     Serial.println("HTTP server started");
 
-    pinMode(BUZZER_PIN, OUTPUT);
+    audio.begin();
 
     statusLEDs.setBrightness(7);
 
     displayState();
 
-    // Open the preferences storage with read/write access
-    preferences.begin("keypad", false);
-
-    // Read the PIN code from flash memory
-    pinCode = preferences.getString("pinCode", "0000");
-
     Homey.begin("Alarm Keypad");
     Homey.setClass("remote");
 
-    Homey.addAction("Set Alarm State", setState);
-    Homey.addAction("handleEufyStateChange", handleEufyStateChange);
+    Homey.addAction("Set Alarm State", HomeyDelegate::of<int>(setState));
+    Homey.addAction("handleEufyStateChange",
+                    HomeyDelegate::of<HomeyStringView>(handleEufyStateChange));
     Homey.addCondition("Get Alarm State", getState);
+
+    keypad.begin();
 }
 
 void loop() {
@@ -214,167 +339,198 @@ void loop() {
     backlight.update();
     ElegantOTA.loop();
     statusLEDs.loop();
+    wifiService->loop();
+    customCommands.apply();
+    userCodes.apply();
+    if (assets.changed()) screens.invalidate();
+
+    KeyEvent event;
+    while (keypad.next(event)) {
+        Serial.printf("%c (%lld us after contact)\n", event.key,
+                      (long long)(esp_timer_get_time() - event.timestampUs));
+        handleKey(event.key);
+    }
 
-    char key = keypad.getKey();
+    screens.loop();
+}
 
-    if (key) {
-        backlight.registerActivity();
+void handleKey(char key) {
+    backlight.registerActivity();
 
-        beep();  // Produce a beep sound
-        displayKeyboardEntry((shouldHideKeyboardEntry) ? '*' : key);
-        Serial.println(key);
+    beep();  // Produce a beep sound
+    if (screens.keyPressed()) return;  // The key only closed an overlay
 
-        if (key == '*') {
-            shouldHideKeyboardEntry = false;
-        }
+    displayKeyboardEntry((shouldHideKeyboardEntry) ? '*' : key);
 
-        if (key == '#') {
-            clearKeyboardEntry();
-            // Process the command when # is pressed
-            parseCommand(currentCommand);
-            currentCommand          = "";  // Clear the current command
-            shouldHideKeyboardEntry = true;
-        } else {
-            currentCommand += key;  // Append key to the current command
-        }
+    if (key == '*') {
+        shouldHideKeyboardEntry = false;
     }
-}
-
-void parseCommand(const String &command) {
-    int separatorIndex = command.indexOf('*');
-    String enteredPin  = "";
 
-    if (separatorIndex != -1) {
-        // Extract PIN code
-        enteredPin = command.substring(0, separatorIndex);
+    if (key == '#') {
+        clearKeyboardEntry();
+        // Process the command when # is pressed
+        if (currentCommand.overflowed()) {
+            invalidCommand();
+        } else {
+            parseCommand(currentCommand.view());
+        }
+        currentCommand.clear();
+        shouldHideKeyboardEntry = true;
     } else {
-        enteredPin = command;
+        currentCommand.append(key);  // Keys past the capacity are dropped
     }
+}
 
-    Serial.print("Entered PIN code: ");
-    Serial.println(pinCode);
-
-    if (enteredPin.equals(pinCode)) {
-        // Set the default command value to 0
-        int commandValue = 0;
-
-        // Check if there is a numeric command after the * character
-        if (separatorIndex < command.length() - 1) {
-            // Extract numeric command after the * character
-            String numericCommand = command.substring(separatorIndex + 1);
-            commandValue          = numericCommand.toInt();
-        }
+void parseCommand(TextView entry) {
+    ParsedCommand command = CommandParser::split(entry);
+    const UserCode *user  = userCodes.verify(command.pin);
 
-        executeCommand(commandValue, command);
-    } else {
+    if (user == nullptr) {
         Serial.println("Incorrect PIN code");
         playErrorNotes();
         displayState();
+        return;
     }
+
+    // Without a numeric command after the * character the default command is 0
+    int commandValue = 0;
+    if (!CommandParser::parseNumber(command.command, commandValue)) {
+        invalidCommand();
+        return;
+    }
+    if (!user->allows(commandValue)) {
+        Serial.printf("Command %d is not allowed for %s\n", commandValue, user->label);
+        invalidCommand();
+        return;
+    }
+
+    Serial.printf("Code of %s accepted\n", user->label);
+    currentUser = user;
+    executeCommand(commandValue, command);
+    currentUser = nullptr;
 }
 
-void savePinCodeToFlash(String &newPinCode) {
-    // Write the new PIN code to flash memory
-    preferences.putString("pinCode", newPinCode);
+// Adds the PIN code of earlier firmware, or "0000" on a new device, as user "owner".
+// Runs once: an empty table later on means every user was removed on purpose.
+void migrateOwnerCode() {
+    if (userCodes.migrated()) return;
+    if (!userCodes.empty()) {
+        userCodes.setMigrated();  // Users were added before migrations were recorded
+        return;
+    }
+
+    char pinCode [CommandBuffer::CAPACITY + 1] = "0000";
+    Preferences preferences;
+    preferences.begin("keypad", true);
+    bool legacy   = preferences.isKey("pinCode");
+    size_t stored = legacy ? preferences.getString("pinCode", pinCode, sizeof(pinCode)) : 0;
     preferences.end();
+
+    TextView code = { pinCode, strlen(pinCode) };
+    if (legacy && (stored == 0 || code.length == 0 || !CommandParser::isDigits(code))) {
+        // Never "0000" instead: that would open the alarm to anyone
+        Serial.println("Stored PIN code unreadable or too long, not migrated; add users over HTTP");
+        userCodes.setMigrated();
+        return;
+    }
+
+    UserCode owner = {};
+    strcpy(owner.label, "owner");
+    owner.digest = userCodes.digest(code);
+    if (userCodes.put(owner) == UserCodes::OK) userCodes.setMigrated();
 }
 
-void beep() { tone(BUZZER_PIN, NOTE_B3, 50); }
+// Key click, cuts a melody short
+void beep() { audio.play(clickMelody, AudioSequencer::CLICK); }
 
 void clearKeyboardEntry() {
-    display.fillRect(KEYBOARD_ENTRY_COLUMN, KEYBOARD_ENTRY_ROW, 84, 48, WHITE);
-    display.display();
-    display_y = KEYBOARD_ENTRY_ROW;
-    display_x = KEYBOARD_ENTRY_COLUMN;
+    entryLength = 0;
+    screens.dismiss(Screen::ENTRY);
+}
+
+void abandonEntry(void *) {
+    Serial.println("Keyboard entry timed out");
+    entryLength = 0;
+    currentCommand.clear();
+    shouldHideKeyboardEntry = true;
 }
 
 void displayKeyboardEntry(char c) {
-    display.setTextSize(1);
-    display.setTextColor(BLACK);
-    display.setCursor(display_x, display_y);
-    display.print(c);
-    display.display();
-    display_x += 6;
+    if (entryLength < CommandBuffer::CAPACITY) entryText [entryLength++] = c;
+
+    // Every key restarts the timeout
+    ScreenManager::Overlay entry;
+    entry.id         = Screen::ENTRY;
+    entry.draw       = drawEntry;
+    entry.durationMs = ENTRY_TIMEOUT_MS;
+    entry.onClose    = abandonEntry;
+    screens.show(entry);
 }
 
 void displayState() {
-    display.clearDisplay();  // Clear the display
-
-    int16_t x = 42;
-    int16_t y = 15;
-    int16_t x1, y1;
-    uint16_t w, h;
-
-    // Determine the size of the array
-    size_t arraySize = sizeof(stateTexts) / sizeof(stateTexts [0]);
-
-    const char *statusText = "ERROR";
-
-    // Search the array for the entry for the current state
-    for (size_t i = 0; i < arraySize; ++i) {
-        if (stateTexts [i].key == state) {
-            statusText = stateTexts [i].value;
-            break;
-        }
-    }
-
-    // Calculate width of new string
-    display.getTextBounds(statusText, x, y, &x1, &y1, &w, &h);
-    display.setCursor(x - w / 2, y);
-    display.setTextColor(BLACK);
-    display.print(statusText);
+    screens.invalidate();
+    statusLEDs.setState(state, stateAcknowledged);
+}
 
-    // Display the text on the screen
-    display.display();
+void drawState(Pcd8544Canvas &display, void *) {
+    // A banner from the assets partition replaces the built-in one
+    char name [AssetPack::NAME_LENGTH];
+    snprintf(name, sizeof(name), "banner/state%d", state);
+    bool drawn = false;
+    assets.read(name, [&](Asset custom) {
+        if (custom.size != Pcd8544Canvas::PANEL_WIDTH) return;
+        display.drawBank(STATE_BANK, custom.data);
+        drawn = true;
+    });
+    if (drawn) return;
 
-    statusLEDs.setState(state, stateAcknowledged);
+    const Banner &banner = state <= MAX_STATE ? stateBanners.banners [state] : stateBanners.error;
+    display.drawBank(STATE_BANK, banner.columns);
 }
 
-void displayInfo() {
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setTextColor(BLACK);
-    display.setCursor(0, 0);
+void drawEntry(Pcd8544Canvas &display, void *) {
+    drawState(display, nullptr);
+    display.drawText(KEYBOARD_ENTRY_COLUMN, KEYBOARD_ENTRY_ROW, entryText, entryLength);
+}
 
+void drawInfo(Pcd8544Canvas &display, void *) {
     IPAddress ip = WiFi.localIP();
     String ipStr = ip.toString();
-    display.println(ipStr);
-
-    display.println("\nBuild Date:");
-    display.println(__DATE__);
-    display.println(__TIME__);
+    display.drawText(0, 0, ipStr.c_str(), ipStr.length());
 
-    display.display();
-
-    delay(5000);
-    requestAlarmStateFromHomey();
+    display.drawText(0, 16, "Build Date:");
+    display.drawText(0, 24, __DATE__);
+    display.drawText(0, 32, __TIME__);
 }
 
-void playSuccessNotes() {
-    tone(BUZZER_PIN, NOTE_C5, 100);
-    tone(BUZZER_PIN, NOTE_D5, 100);
-    tone(BUZZER_PIN, NOTE_F5, 100);
-    tone(BUZZER_PIN, NOTE_G5, 100);
+void displayInfo() {
+    // Shown for a while or until a key is pressed, then the state is refreshed
+    ScreenManager::Overlay info;
+    info.id           = Screen::INFO;
+    info.draw         = drawInfo;
+    info.durationMs   = INFO_SCREEN_MS;
+    info.dismissOnKey = true;
+    info.onClose      = [](void *) { requestAlarmStateFromHomey(); };
+    screens.show(info);
 }
 
-void playAcknowledgeNotes() {
-    tone(BUZZER_PIN, NOTE_G5, 150);
-    tone(BUZZER_PIN, NOTE_F5, 200);
-}
+void playSuccessNotes() { audio.play(successMelody, AudioSequencer::FEEDBACK); }
 
-void playErrorNotes() { tone(BUZZER_PIN, NOTE_A2, 500); }
+void playAcknowledgeNotes() { audio.play(acknowledgeMelody, AudioSequencer::FEEDBACK); }
 
-void setState() {
-    state = Homey.value.toInt();
-    applyState();
+void playErrorNotes() { audio.play(errorMelody, AudioSequencer::FEEDBACK); }
 
-    displayState();
+void setState(int newState) {
+    state = newState;
+    applyState();
 }
 
-void handleEufyStateChange() {
-    Serial.println("Eufy changed Alarm State to " + Homey.value);
+void handleEufyStateChange(HomeyStringView eufyState) {
+    Serial.print("Eufy changed Alarm State to ");
+    Serial.write(eufyState.data, eufyState.length);
+    Serial.println();
 
-    int newState = mapEufyState(Homey.value);
+    int newState = mapEufyState(eufyState);
     if (newState < 0) return;
 
     state             = newState;
@@ -389,23 +545,26 @@ void getState() {
     return Homey.returnResult(state);
 }
 
-String normalizeString(const String &input) {
-    String result = input;
-    result.trim();         // Remove leading/trailing spaces
-    result.toLowerCase();  // Convert to lowercase
-    return result;
-}
-
-int mapEufyState(const String &state) {
-    String normalizedState = normalizeString(state);
+int mapEufyState(HomeyStringView state) {
+    // Ignore leading/trailing spaces and case, without copying the argument
+    const char *text = state.data;
+    size_t length    = state.length;
+    while (length > 0 && isspace(text [0])) {
+        text++;
+        length--;
+    }
+    while (length > 0 && isspace(text [length - 1])) length--;
 
-    auto eufyState = eufyStateMapping.find(normalizedState);
-    if (eufyState == eufyStateMapping.end()) {
-        Serial.print("Invalid eufy state: ");
-        Serial.println(state);
-        return -1;
+    for (const KeyValue &eufyState : eufyStateMapping) {
+        if (strlen(eufyState.value) == length && strncasecmp(eufyState.value, text, length) == 0) {
+            return eufyState.key;
+        }
     }
-    return eufyState->second;
+
+    Serial.print("Invalid eufy state: ");
+    Serial.write(state.data, state.length);
+    Serial.println();
+    return -1;
 }
 
 void applyState() {
@@ -423,7 +582,7 @@ void triggerHomey() {
 
     String trigger = triggerMapping->second;
     Serial.println("Trigger Homey: " + trigger);
-    Homey.trigger(trigger, true);
+    Homey.trigger(trigger, currentUser ? currentUser->label : "homey");  // Who changed the state
 }
 
 void requestAlarmStateFromHomey() {
@@ -431,18 +590,263 @@ void requestAlarmStateFromHomey() {
     Homey.trigger("getAlarmState");
 }
 
-void executeCommand(int commandValue, const String &command) {
-    if (commandValue == CMD_CHANGE_PIN) {
-        handlePinChange(command);
+void runCommand(const Command *command, TextView argument) {
+    if (command == nullptr || command->takesArgument != (argument.length > 0)) {
+        invalidCommand();
         return;
     }
+    command->handler(argument);
+}
 
-    auto commandHandler = commandHandlers.find(commandValue);
-    if (commandHandler == commandHandlers.end()) {
+// "[-+]<digits>[.<digits>]" and nothing else: no blanks, exponent, hex, inf or nan
+bool isDecimal(TextView text, bool &fraction) {
+    if (text.length > 0 && (text.data [0] == '-' || text.data [0] == '+')) {
+        text = { text.data + 1, text.length - 1 };
+    }
+    const char *point = static_cast<const char *>(memchr(text.data, '.', text.length));
+    TextView whole    = { text.data, point ? size_t(point - text.data) : text.length };
+    TextView decimals = { point ? point + 1 : text.data + text.length,
+                          point ? text.length - whole.length - 1 : 0 };
+    fraction          = point != nullptr;
+    return whole.length > 0 && CommandParser::isDigits(whole) &&
+           (!fraction || (decimals.length > 0 && CommandParser::isDigits(decimals)));
+}
+
+// Sends a capability value as the type it spells: true/false, a number or else text
+void setCapability(const CustomCommand &custom) {
+    const char *value = custom.value;
+    bool fraction     = false;
+
+    if (strcmp(value, "true") == 0 || strcmp(value, "false") == 0) {
+        Homey.setCapabilityValue(custom.name, value [0] == 't');
+    } else if (!isDecimal({ value, strlen(value) }, fraction)) {
+        Homey.setCapabilityValue(custom.name, value);
+    } else if (!fraction && strlen(value) <= CommandParser::MAX_DIGITS) {
+        Homey.setCapabilityValue(custom.name, static_cast<int>(strtol(value, nullptr, 10)));
+    } else {
+        Homey.setCapabilityValue(custom.name, strtod(value, nullptr));
+    }
+}
+
+void executeCommand(int commandValue, const ParsedCommand &command) {
+    // Built-in codes cannot be redefined, so a custom command never locks them out
+    const Command *builtin      = CommandTable::find(commands, commandValue);
+    const CustomCommand *custom = builtin ? nullptr : customCommands.find(commandValue);
+    if (custom == nullptr) {
+        runCommand(builtin, command.argument);
+        return;
+    }
+
+    if (custom->action == CustomCommand::BUILTIN) {
+        int target = -1;  // No such command, unless value holds a code
+        CommandParser::parseNumber({ custom->value, strlen(custom->value) }, target);
+        runCommand(CommandTable::find(commands, target), command.argument);
+        return;
+    }
+
+    if (command.argument.length > 0) {
         invalidCommand();
         return;
     }
-    commandHandler->second();  // Call the function mapped to the command
+    if (custom->action == CustomCommand::TRIGGER) {
+        Serial.printf("Triggering %s\n", custom->name);
+        Homey.trigger(custom->name, currentUser->label);
+    } else {
+        Serial.printf("Setting %s to %s\n", custom->name, custom->value);
+        setCapability(*custom);
+    }
+    playSuccessNotes();
+}
+
+// Request parameter from the query string or a form body, nullptr when absent
+const AsyncWebParameter *findParam(AsyncWebServerRequest *request, const char *name) {
+    return request->hasParam(name, true) ? request->getParam(name, true) : request->getParam(name);
+}
+
+// Copies a non-empty parameter into a fixed field, false when it is missing or too long
+bool copyParam(AsyncWebServerRequest *request, const char *name, char *field, size_t size) {
+    const AsyncWebParameter *param = findParam(request, name);
+    if (param == nullptr || param->value().length() == 0 || param->value().length() >= size) {
+        return false;
+    }
+    strcpy(field, param->value().c_str());
+    return true;
+}
+
+bool readCommandCode(AsyncWebServerRequest *request, int &code) {
+    const AsyncWebParameter *param = findParam(request, "code");
+    if (param == nullptr || param->value().length() == 0) return false;
+    return CommandParser::parseNumber({ param->value().c_str(), param->value().length() }, code);
+}
+
+// code=<digits>&action=trigger&name=<trigger>
+// code=<digits>&action=capability&name=<capability>&value=<value>
+// code=<digits>&action=builtin&value=<built-in code>
+bool readCustomCommand(AsyncWebServerRequest *request, CustomCommand &command) {
+    int code = 0;
+    if (!readCommandCode(request, code)) return false;
+    command.code = code;
+
+    const AsyncWebParameter *action = findParam(request, "action");
+    if (action == nullptr) return false;
+
+    if (action->value() == "trigger") {
+        command.action = CustomCommand::TRIGGER;
+        return copyParam(request, "name", command.name, sizeof(command.name));
+    }
+    if (action->value() == "capability") {
+        command.action = CustomCommand::CAPABILITY;
+        return copyParam(request, "name", command.name, sizeof(command.name)) &&
+               copyParam(request, "value", command.value, sizeof(command.value));
+    }
+    if (action->value() == "builtin") {
+        command.action = CustomCommand::BUILTIN;
+        int target     = 0;
+        return copyParam(request, "value", command.value, sizeof(command.value)) &&
+               CommandParser::parseNumber({ command.value, strlen(command.value) }, target) &&
+               CommandTable::find(commands, target) != nullptr;
+    }
+    return false;
+}
+
+void addCommandRoutes() {
+    server.on("/commands", HTTP_GET, [](AsyncWebServerRequest *request) {
+        AsyncResponseStream *response = request->beginResponseStream("text/plain");
+        customCommands.print(*response);
+        request->send(response);
+    });
+
+    server.on("/commands", HTTP_POST, [](AsyncWebServerRequest *request) {
+        CustomCommand command = {};
+        if (!readCustomCommand(request, command)) {
+            request->send(400, "text/plain", "Invalid command\n");
+        } else if (CommandTable::find(commands, command.code) != nullptr) {
+            request->send(409, "text/plain", "Code is a built-in command\n");
+        } else if (!customCommands.put(command)) {
+            request->send(507, "text/plain", "Command table full or not saved\n");
+        } else {
+            request->send(200, "text/plain", "OK\n");
+        }
+    });
+
+    server.on("/commands", HTTP_DELETE, [](AsyncWebServerRequest *request) {
+        int code = 0;
+        if (!readCommandCode(request, code)) {
+            request->send(400, "text/plain", "Invalid code\n");
+        } else if (!customCommands.remove(code)) {
+            request->send(404, "text/plain", "No such command\n");
+        } else {
+            request->send(200, "text/plain", "OK\n");
+        }
+    });
+}
+
+// Unix time in seconds, 0 when the parameter is absent
+bool readTime(AsyncWebServerRequest *request, const char *name, uint32_t &time) {
+    const AsyncWebParameter *param = findParam(request, name);
+    if (param == nullptr) return true;
+    char *end;
+    time = strtoul(param->value().c_str(), &end, 10);
+    return param->value().length() > 0 && *end == '\0';
+}
+
+// Comma separated command codes, "*" or empty for all commands
+bool readAllowedCommands(AsyncWebServerRequest *request, UserCode &user) {
+    const AsyncWebParameter *param = findParam(request, "allow");
+    if (param == nullptr) return true;
+
+    user.allowedCount = 0;
+    if (param->value().length() == 0 || param->value() == "*") return true;
+
+    const char *text = param->value().c_str();
+    while (true) {
+        const char *comma = strchr(text, ',');
+        size_t length     = comma ? comma - text : strlen(text);
+        int code          = 0;
+        if (user.allowedCount == UserCode::MAX_ALLOWED || length == 0 ||
+            !CommandParser::parseNumber({ text, length }, code)) {
+            return false;
+        }
+        user.allowedCommands [user.allowedCount++] = code;
+        if (comma == nullptr) return true;
+        text = comma + 1;
+    }
+}
+
+// label=<label>&code=<digits>&from=<unix time>&until=<unix time>&allow=<codes>
+// Omitted fields of an existing user are kept, a new user needs a code
+bool readUserCode(AsyncWebServerRequest *request, UserCode &user) {
+    char label [UserCode::LABEL_SIZE];
+    if (!copyParam(request, "label", label, sizeof(label)) || strchr(label, ' ') != nullptr) {
+        return false;
+    }
+
+    bool known = userCodes.get(label, user);
+    if (!known) {
+        user = {};
+        strcpy(user.label, label);
+    }
+
+    const AsyncWebParameter *code = findParam(request, "code");
+    if (code != nullptr) {
+        TextView digits = { code->value().c_str(), code->value().length() };
+        if (digits.length == 0 || digits.length > CommandBuffer::CAPACITY ||
+            !CommandParser::isDigits(digits)) {
+            return false;
+        }
+        user.digest = userCodes.digest(digits);
+    } else if (!known) {
+        return false;
+    }
+
+    return readTime(request, "from", user.validFrom) &&
+           readTime(request, "until", user.validUntil) && readAllowedCommands(request, user);
+}
+
+void addUserRoutes() {
+    server.on("/users", HTTP_GET, [](AsyncWebServerRequest *request) {
+        AsyncResponseStream *response = request->beginResponseStream("text/plain");
+        userCodes.print(*response);
+        request->send(response);
+    });
+
+    server.on("/users", HTTP_POST, [](AsyncWebServerRequest *request) {
+        UserCode user;
+        if (!readUserCode(request, user)) {
+            request->send(400, "text/plain", "Invalid user\n");
+            return;
+        }
+        switch (userCodes.put(user)) {
+            case UserCodes::OK:
+                request->send(200, "text/plain", "OK\n");
+                break;
+            case UserCodes::DUPLICATE_CODE:
+                request->send(409, "text/plain", "Code already in use\n");
+                break;
+            default:
+                request->send(507, "text/plain", "User table full or not saved\n");
+                break;
+        }
+    });
+
+    server.on("/users", HTTP_DELETE, [](AsyncWebServerRequest *request) {
+        const AsyncWebParameter *label = findParam(request, "label");
+        if (label == nullptr) {
+            request->send(400, "text/plain", "Invalid label\n");
+            return;
+        }
+        switch (userCodes.remove(label->value().c_str())) {
+            case UserCodes::OK:
+                request->send(200, "text/plain", "OK\n");
+                break;
+            case UserCodes::NOT_FOUND:
+                request->send(404, "text/plain", "No such user\n");
+                break;
+            default:
+                request->send(507, "text/plain", "User not removed\n");
+                break;
+        }
+    });
 }
 
 void changeAlarmState(int newState, const char *message) {
@@ -453,25 +857,57 @@ void changeAlarmState(int newState, const char *message) {
     playSuccessNotes();
 }
 
-void handlePinChange(const String &command) {
-    int positionOfFirstStar = command.indexOf('*');
-    int newPinIndex         = command.indexOf('*', positionOfFirstStar + 1);
-    if (newPinIndex != -1) {
-        String newPin = command.substring(newPinIndex + 1);
-        pinCode       = newPin;
-        Serial.print("PIN code changed to: ");
-        Serial.println(pinCode);
-        savePinCodeToFlash(pinCode);
-        playSuccessNotes();
-        playSuccessNotes();
+void handlePinChange(TextView newPin) {
+    // <pin>*99*<new pin> changes the code of whoever entered it. Every refusal
+    // sounds the same, so the keypad does not tell a taken code from a typo.
+    const char *refusal = nullptr;
+    if (newPin.length == 0 || !CommandParser::isDigits(newPin)) {
+        refusal = "invalid format";
+    } else {
+        UserCode user = *currentUser;
+        user.digest   = userCodes.digest(newPin);
+        switch (userCodes.put(user)) {
+            case UserCodes::OK:
+                break;
+            case UserCodes::DUPLICATE_CODE:
+                refusal = "in use by another user";
+                break;
+            default:
+                refusal = "not saved";
+                break;
+        }
+    }
+
+    if (refusal != nullptr) {
+        Serial.printf("PIN code of %s not changed: %s\n", currentUser->label, refusal);
+        playErrorNotes();
         return;
     }
-    Serial.println("Invalid command format");
+    Serial.printf("PIN code of %s changed\n", currentUser->label);
+    playSuccessNotes();
+    audio.queue(successMelody, AudioSequencer::FEEDBACK);
+}
+
+// Before the assets partition is rewritten, from the web server
+void releaseAssets() {
+    audio.stop();  // The melody may come from the partition
 }
 
 void playMonkeyIslandTheme() {
     Serial.println("Playing Monkey Island Theme :-D");
-    playMonkeyIslandTune(BUZZER_PIN);
+
+    // A melody from the assets partition replaces the built-in one
+    // Started inside read(), so an update stops it before rewriting the partition
+    static MelodyStream custom;
+    bool played = false;
+    assets.read("melody/easteregg", [&](Asset asset) {
+        audio.stop();  // custom may still be playing
+        if (asset && MelodyStream::parse(asset.data, asset.size, custom)) {
+            audio.play(custom, AudioSequencer::MELODY);
+            played = true;
+        }
+    });
+    if (!played) audio.play(monkeyIslandTune, AudioSequencer::MELODY);
 }
 
 void invalidCommand() {
@@ -479,3 +915,51 @@ void invalidCommand() {
     playErrorNotes();
     displayState();
 }
+
+// Outcome of one upload to /assets
+struct AssetUpload {
+    AssetPartition::Update update;
+    bool failed;  // A write to the partition failed
+};
+
+void addAssetRoutes() {
+    server.on("/assets", HTTP_GET, [](AsyncWebServerRequest *request) {
+        AsyncResponseStream *response = request->beginResponseStream("text/plain");
+        assets.print(*response);
+        request->send(response);
+    });
+
+    // The container is uploaded as a multipart file and written as it arrives
+    server.on(
+        "/assets", HTTP_POST,
+        [](AsyncWebServerRequest *request) {
+            const AssetUpload *upload = static_cast<AssetUpload *>(request->_tempObject);
+            if (upload == nullptr) {
+                request->send(400, "text/plain", "No file\n");
+                return;
+            }
+            if (upload->update == AssetPartition::BUSY) {
+                request->send(409, "text/plain", "Another update is running\n");
+                return;
+            }
+            AssetPack::Status status = assets.status();
+            int code = upload->update != AssetPartition::STARTED || upload->failed ? 507
+                       : status == AssetPack::OK                                   ? 200
+                                                                                   : 400;
+            request->send(code, "text/plain", String(AssetPack::statusText(status)) + "\n");
+        },
+        [](AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data,
+           size_t length, bool final) {
+            // The request frees _tempObject, so every upload keeps its own outcome
+            AssetUpload *upload = static_cast<AssetUpload *>(request->_tempObject);
+            if (index == 0 && upload == nullptr) {
+                upload = static_cast<AssetUpload *>(malloc(sizeof(AssetUpload)));
+                if (upload == nullptr) return;
+                *upload              = { assets.beginUpdate(releaseAssets), false };
+                request->_tempObject = upload;
+            }
+            if (upload == nullptr || upload->update != AssetPartition::STARTED) return;
+            if (!upload->failed && !assets.write(data, length)) upload->failed = true;
+            if (final) assets.endUpdate();
+        });
+}
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""Builds an asset container for the keypad's assets partition (src/AssetPack.hpp).
+
+Assets are given as name=source pairs; names are up to 23 characters:
+
+    python3 tools/asset_pack.py -o assets.bin \\
+        --melody melody/easteregg=tools/melodies/monkey_island.csv \\
+        --banner banner/state3=INBRAAK \\
+        --file banner/state9=disarmed.bin
+
+    --melody  a melody CSV (see tools/melody_stream.py), stored as one block:
+              uint8 number of frequencies, a zero byte, the frequencies as
+              uint16 and then the note stream
+    --banner  text rendered into one centred display bank (84 bytes) with the
+              firmware's 5x7 font from src/Font5x7.hpp
+    --file    any file, stored as is
+
+The keypad uses `banner/state<N>` for alarm state N and `melody/easteregg` for
+code 1990 when they are present. Upload the result with
+
+    curl -F 'file=@assets.bin' http://keypad.local/assets
+
+or write it to the partition at 0x290000 with esptool. `--list` prints the
+entries of an existing container instead.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import melody_stream  # noqa: E402
+
+MAGIC = b"KPAK"
+VERSION = 1
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<24sII")
+NAME_LENGTH = 24
+ALIGNMENT = 4
+
+PANEL_WIDTH = 84
+FONT_ADVANCE = 6
+FONT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "Font5x7.hpp")
+
+
+def melody_asset(path):
+    _, notes = melody_stream.read_melody(path)
+    frequencies, stream = melody_stream.encode(notes)
+    table = struct.pack(f"<{len(frequencies)}H", *frequencies)
+    return bytes([len(frequencies), 0]) + table + stream
+
+
+def load_font():
+    with open(FONT_HEADER) as header:
+        rows = re.findall(r"\{\s*((?:0x[0-9A-Fa-f]{2},\s*){4}0x[0-9A-Fa-f]{2})\s*\}", header.read())
+    if len(rows) != 95:
+        sys.exit(f"{FONT_HEADER}: expected 95 glyphs, found {len(rows)}")
+    return [[int(column, 16) for column in row.split(",")] for row in rows]
+
+
+def banner_asset(text, font):
+    length = min(len(text), (PANEL_WIDTH + 1) // FONT_ADVANCE)
+    width = length * FONT_ADVANCE - 1 if length else 0
+    column = (PANEL_WIDTH - width) // 2
+
+    columns = bytearray(PANEL_WIDTH)
+    for character in text[:length]:
+        code = ord(character)
+        glyph = font[code - 32] if 32 <= code <= 126 else font[ord("?") - 32]
+        columns[column:column + len(glyph)] = bytes(glyph)
+        column += FONT_ADVANCE
+    return bytes(columns)
+
+
+def pack(assets):
+    names = sorted(assets, key=lambda name: name.encode())
+    offset = HEADER.size + len(names) * ENTRY.size
+    table, data = bytearray(), bytearray()
+
+    for name in names:
+        encoded = name.encode()
+        if len(encoded) >= NAME_LENGTH:
+            sys.exit(f"asset name '{name}' is longer than {NAME_LENGTH - 1} bytes")
+        padding = -(offset + len(data)) % ALIGNMENT
+        data += bytes(padding)
+        table += ENTRY.pack(encoded, offset + len(data), len(assets[name]))
+        data += assets[name]
+
+    body = bytes(table + data)
+    return HEADER.pack(MAGIC, VERSION, len(names), HEADER.size + len(body), zlib.crc32(body)) + body
+
+
+def list_container(path):
+    with open(path, "rb") as source:
+        container = source.read()
+    magic, version, count, size, crc = HEADER.unpack_from(container)
+    if magic != MAGIC or version != VERSION:
+        sys.exit(f"{path}: not a version {VERSION} asset container")
+    if size > len(container) or zlib.crc32(container[HEADER.size:size]) != crc:
+        sys.exit(f"{path}: incomplete or damaged")
+    print(f"{count} entries, {size} bytes")
+    for i in range(count):
+        name, offset, length = ENTRY.unpack_from(container, HEADER.size + i * ENTRY.size)
+        name = name.rstrip(b"\0").decode()
+        print(f"{name} {length} bytes at {offset}")
+
+
+def pairs(values, seen):
+    for value in values or []:
+        name, separator, source = value.partition("=")
+        if not separator or not name:
+            sys.exit(f"expected name=source, got '{value}'")
+        if name in seen:
+            sys.exit(f"asset '{name}' given twice")
+        seen.add(name)
+        yield name, source
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", help="container to write")
+    parser.add_argument("--melody", action="append", metavar="NAME=CSV")
+    parser.add_argument("--banner", action="append", metavar="NAME=TEXT")
+    parser.add_argument("--file", action="append", metavar="NAME=PATH")
+    parser.add_argument("--list", metavar="CONTAINER", help="list an existing container")
+    args = parser.parse_args()
+
+    if args.list:
+        list_container(args.list)
+        return
+    if not args.output:
+        parser.error("--output is required")
+
+    assets, seen = {}, set()
+    font = load_font() if args.banner else None
+    for name, source in pairs(args.melody, seen):
+        assets[name] = melody_asset(source)
+    for name, text in pairs(args.banner, seen):
+        assets[name] = banner_asset(text, font)
+    for name, path in pairs(args.file, seen):
+        with open(path, "rb") as source:
+            assets[name] = source.read()
+
+    container = pack(assets)
+    with open(args.output, "wb") as output:
+        output.write(container)
+    print(f"{len(assets)} assets, {len(container)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,56 @@
+// Checks an asset container with the firmware's own reader (src/AssetPack.hpp)
+// and lists its entries; melodies are decoded note by note like on the keypad.
+//
+//   pio run -e assets && .pio/build/assets/program assets.bin
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "AssetPack.hpp"
+#include "MelodyStream.hpp"
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <container>\n", argv [0]);
+        return 2;
+    }
+
+    FILE *file = fopen(argv [1], "rb");
+    if (file == nullptr) {
+        perror(argv [1]);
+        return 2;
+    }
+    std::vector<uint8_t> container;
+    uint8_t chunk [4096];
+    for (size_t length; (length = fread(chunk, 1, sizeof(chunk), file)) > 0;) {
+        container.insert(container.end(), chunk, chunk + length);
+    }
+    fclose(file);
+
+    AssetPack pack;
+    AssetPack::Status status = pack.open(container.data(), container.size());
+    printf("%s: %s\n", argv [1], AssetPack::statusText(status));
+    if (status != AssetPack::OK) return 1;
+
+    for (uint16_t i = 0; i < pack.count(); i++) {
+        const char *name = pack.name(i);
+        Asset asset      = pack.asset(i);
+        printf("%-24s %6zu bytes", name, asset.size);
+
+        MelodyStream melody;
+        bool isMelody = strncmp(name, "melody/", 7) == 0;
+        if (isMelody && MelodyStream::parse(asset.data, asset.size, melody)) {
+            MelodyCursor cursor = {};
+            Note note;
+            uint32_t notes = 0, durationMs = 0;
+            while (melody.next(cursor, note)) {
+                notes++;
+                durationMs += note.durationMs;
+            }
+            printf(", %u notes, %.1f s", unsigned(notes), durationMs / 1000.0);
+        }
+        printf("\n");
+    }
+    return 0;
+}
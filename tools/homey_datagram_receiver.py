@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Reference receiver for the Homey datagram transport (lib/homey/HomeyDatagram).
+
+Listens for event datagrams, acknowledges them and reports duplicates and
+sequence gaps per sender. Use it as a local stand-in for a LAN consumer:
+
+    python3 tools/homey_datagram_receiver.py --port 46641 --drop 0.2
+
+and point the keypad at it with `Homey.beginDatagram(host, 46641)`.
+"""
+
+import argparse
+import json
+import random
+import signal
+import socket
+import struct
+import sys
+import time
+
+MAGIC = ord("H")
+VERSION = 2
+KIND_EVENT = 1
+KIND_ACK = 2
+ACK_ACCEPTED = 0
+ACK_DUPLICATE = 1
+HEADER = struct.Struct(">BBHH")
+
+ARG_TYPES = {"n": "null", "S": "String", "N": "Number", "B": "Boolean"}
+
+# Number of sequence numbers behind the newest one that are remembered for
+# duplicate detection. Must be larger than the sender's DATAGRAM_WINDOW.
+HISTORY = 256
+
+
+def seq_diff(a, b):
+    """Signed distance from b to a in 16-bit serial number arithmetic."""
+    return ((a - b + 0x8000) & 0xFFFF) - 0x8000
+
+
+class Session:
+    def __init__(self, sequence):
+        self.newest = (sequence - 1) & 0xFFFF
+        self.seen = set()
+        self.missing = set()
+        self.events = 0
+        self.duplicates = 0
+        self.gaps = 0
+        self.late = 0
+
+    def accept(self, sequence):
+        """Returns True for a new event, False for a duplicate."""
+        delta = seq_diff(sequence, self.newest)
+        if delta > 0:
+            for skipped in range(1, delta):
+                self.missing.add((self.newest + skipped) & 0xFFFF)
+            self.gaps += delta - 1
+            self.newest = sequence
+            self.seen = {s for s in self.seen if seq_diff(sequence, s) < HISTORY}
+            self.missing = {s for s in self.missing if seq_diff(sequence, s) < HISTORY}
+        elif sequence in self.seen or -delta >= HISTORY:
+            self.duplicates += 1
+            return False
+        elif sequence in self.missing:
+            self.missing.discard(sequence)
+            self.gaps -= 1
+            self.late += 1
+        self.seen.add(sequence)
+        self.events += 1
+        return True
+
+
+def parse_event(payload):
+    ev_type, device, name, rest = payload.split(b"\0", 3)
+    arg_type = ARG_TYPES.get(chr(rest[0]), "unknown")
+    argument = json.loads(rest[1:].decode()) if len(rest) > 1 else None
+    return ev_type.decode(), device.decode(), name.decode(), arg_type, argument
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--bind", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=46641)
+    parser.add_argument("--drop", type=float, default=0.0,
+                        help="fraction of packets to drop before acking, to exercise retransmission")
+    parser.add_argument("--quiet", action="store_true", help="only print the summary")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind((args.bind, args.port))
+    sessions = {}
+    dropped = 0
+    started = time.monotonic()
+
+    def summary(*_):
+        elapsed = time.monotonic() - started
+        print("--- %.1f s, %d dropped on purpose" % (elapsed, dropped), file=sys.stderr)
+        for (host, session_id), s in sessions.items():
+            print("%s session %04x: events=%d duplicates=%d gaps=%d late=%d"
+                  % (host, session_id, s.events, s.duplicates, s.gaps, s.late), file=sys.stderr)
+        sys.exit(0)
+
+    signal.signal(signal.SIGINT, summary)
+    signal.signal(signal.SIGTERM, summary)
+    print("listening on %s:%d" % (args.bind, args.port), file=sys.stderr)
+
+    while True:
+        packet, sender = sock.recvfrom(1500)
+        received = time.time()
+        if len(packet) < HEADER.size:
+            continue
+        magic, version_kind, session_id, sequence = HEADER.unpack_from(packet)
+        if magic != MAGIC or version_kind != (VERSION << 4 | KIND_EVENT):
+            continue
+        if args.drop and random.random() < args.drop:
+            dropped += 1
+            continue
+
+        key = (sender[0], session_id)
+        if key not in sessions:
+            sessions[key] = Session(sequence)
+        is_new = sessions[key].accept(sequence)
+
+        ack = HEADER.pack(MAGIC, VERSION << 4 | KIND_ACK, session_id, sequence)
+        sock.sendto(ack + bytes([ACK_ACCEPTED if is_new else ACK_DUPLICATE]), sender)
+
+        if is_new and not args.quiet:
+            ev_type, device, name, arg_type, argument = parse_event(packet[HEADER.size:])
+            print(json.dumps({"time": received, "from": sender[0], "seq": sequence,
+                              "event": ev_type, "device": device, "name": name,
+                              "type": arg_type, "argument": argument}), flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,484 @@
+/*
+ * Many Homeyduino keypads in one Linux process (HOMEY_USE_POSIX), for scale
+ * testing Homey and the bridge.
+ *
+ * Every emulated device is a full HomeyClass, so requests, discovery and the
+ * index are handled by the library itself. With --address every device gets
+ * its own IP address (the first one given, the others following) and listens
+ * on the standard port, so Homey discovers all of them; broadcast discoveries
+ * arrive on one shared socket and are answered by every device from its own
+ * address. Without --address the devices share the host's addresses on
+ * consecutive ports, which is enough for load tests but only the first one is
+ * found by discovery.
+ *
+ * One epoll loop waits on all sockets. Connections are accepted by the loop
+ * and handed to their device only when the request is complete, so a slow
+ * client never holds up the other devices. Devices emit triggers at a
+ * configurable rate as datagrams, and the emulator reports request and emit
+ * throughput and latency percentiles. Emits over HTTP are not offered: the
+ * library connects, sends and waits for the answer synchronously, which would
+ * stall every device behind one slow master.
+ *
+ *   pio run -e emulator && .pio/build/emulator/program --devices 200 --emit-rate 0.5 \
+ *       --datagram 127.0.0.1:46641
+ *   sudo ip addr add 192.168.1.100/24 dev eth0 ...     (one address per device)
+ *   .pio/build/emulator/program --devices 50 --address 192.168.1.100
+ */
+
+#include <Homey.h>
+
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <vector>
+
+#define EMULATOR_TICK_MS	5		//Granularity of emits and datagram retransmissions
+#define EMULATOR_EVENTS		256		//epoll events handled per wakeup
+
+//What an epoll event is about, kept in the upper half of its data
+#define SOURCE_LISTEN		0		//Listening socket of a device (lower half: device index)
+#define SOURCE_DISCOVERY	1		//Discovery socket of a device (lower half: device index)
+#define SOURCE_CONNECTION	2		//Accepted connection (lower half: descriptor)
+#define SOURCE_BROADCAST	3		//Shared socket for broadcast discoveries
+
+struct EmulatedDevice {
+	HomeyClass* homey;
+	int state;
+	uint64_t nextEmitUs;												//0: this device does not emit
+	uint32_t actions;
+};
+
+//A connection whose request is still arriving
+struct Connection {
+	int device;															//-1: descriptor not in use
+	uint64_t acceptedUs;
+};
+
+struct Options {
+	uint16_t devices;
+	uint16_t port;
+	IPAddress address;													//Address of the first device (0.0.0.0: one address, consecutive ports)
+	IPAddress broadcast;
+	double emitRate;													//Events per second per device
+	IPAddress datagramHost;
+	uint16_t datagramPort;
+	unsigned int interval;
+	unsigned int duration;
+};
+
+//Latency samples of one reporting interval, in microseconds
+struct Samples {
+	std::vector<uint32_t> values;
+
+	void add(uint32_t us) { values.push_back(us); }
+	uint32_t percentile(double p) {
+		if (values.empty()) return 0;
+		size_t index = (size_t) (p * (values.size()-1) + 0.5);
+		std::nth_element(values.begin(), values.begin()+index, values.end());
+		return values[index];
+	}
+	uint32_t max() { return values.empty() ? 0 : *std::max_element(values.begin(), values.end()); }
+};
+
+//Counters summed over all devices from the library statistics
+struct Totals {
+	uint64_t requests;
+	uint64_t discoveries;
+	uint64_t emits;
+	uint64_t emitsOk;
+};
+
+volatile sig_atomic_t running = 1;
+
+void stopRunning(int)
+{
+	running = 0;
+}
+
+uint64_t nowUs()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t) now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
+
+void setState(EmulatedDevice* device, int state)
+{
+	device->state = state;
+	device->actions++;
+}
+
+void getState(EmulatedDevice* device)
+{
+	device->homey->returnResult(device->state);
+}
+
+bool parseHostPort(const char* text, IPAddress& host, uint16_t& port)
+{
+	const char* colon = strchr(text, ':');
+	if (colon==NULL) return false;
+	String address = String(text).substring(0, colon-text);
+	port = atoi(colon+1);
+	return (port>0) && host.fromString(address);
+}
+
+void usage(const char* program)
+{
+	fprintf(stderr,
+		"usage: %s [options]\n"
+		"  -n, --devices N         number of emulated keypads (100)\n"
+		"  -a, --address ADDR      address of the first device, the others follow; the addresses\n"
+		"                          must be assigned to this host (default: consecutive ports)\n"
+		"  -b, --broadcast ADDR    broadcast address discoveries arrive at, with --address\n"
+		"                          (255.255.255.255)\n"
+		"  -p, --port PORT         port of every device with --address (46639), otherwise of the\n"
+		"                          first device, the others follow (47000)\n"
+		"  -r, --emit-rate R       triggers per second per device, needs --datagram (0)\n"
+		"  -g, --datagram HOST:PORT  send events as UDP datagrams (see HomeyDatagram)\n"
+		"  -i, --interval S        seconds between reports (5)\n"
+		"  -d, --duration S        stop after S seconds (0: run until interrupted)\n",
+		program);
+}
+
+//With --address every device listens on the same port of its own address
+bool sharedPort(const Options& options)
+{
+	return options.address!=IPAddress(0,0,0,0);
+}
+
+IPAddress deviceAddress(const Options& options, uint16_t index)
+{
+	if (!sharedPort(options)) return options.address;
+	return IPAddress((uint32_t) htonl(ntohl((uint32_t) options.address) + index));
+}
+
+uint16_t devicePort(const Options& options, uint16_t index)
+{
+	return sharedPort(options) ? options.port : options.port + index;
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+	options.devices = 100;
+	options.port = 0;
+	options.address = IPAddress(0,0,0,0);
+	options.broadcast = IPAddress(255,255,255,255);
+	options.emitRate = 0;
+	options.datagramPort = 0;
+	options.interval = 5;
+	options.duration = 0;
+
+	static const struct option longOptions[] = {
+		{ "devices",	required_argument, NULL, 'n' },
+		{ "address",	required_argument, NULL, 'a' },
+		{ "broadcast",	required_argument, NULL, 'b' },
+		{ "port",		required_argument, NULL, 'p' },
+		{ "emit-rate",	required_argument, NULL, 'r' },
+		{ "datagram",	required_argument, NULL, 'g' },
+		{ "interval",	required_argument, NULL, 'i' },
+		{ "duration",	required_argument, NULL, 'd' },
+		{ NULL, 0, NULL, 0 }
+	};
+
+	int option;
+	while ((option = getopt_long(argc, argv, "n:a:b:p:r:g:i:d:", longOptions, NULL))!=-1) {
+		switch (option) {
+			case 'n': options.devices = atoi(optarg); break;
+			case 'a': if (!options.address.fromString(optarg)) return false; break;
+			case 'b': if (!options.broadcast.fromString(optarg)) return false; break;
+			case 'p': options.port = atoi(optarg); break;
+			case 'r': options.emitRate = atof(optarg); break;
+			case 'g': if (!parseHostPort(optarg, options.datagramHost, options.datagramPort)) return false; break;
+			case 'i': options.interval = atoi(optarg); break;
+			case 'd': options.duration = atoi(optarg); break;
+			default: return false;
+		}
+	}
+	if (options.port==0) options.port = sharedPort(options) ? 46639 : 47000;
+	if ((options.emitRate>0) && (options.datagramPort==0)) {
+		fprintf(stderr, "--emit-rate needs --datagram, HTTP emits would block the loop\n");
+		return false;
+	}
+	if (sharedPort(options)) return (options.devices>0) && (options.interval>0);
+	return (options.devices>0) && (options.interval>0) && ((uint32_t) options.port + options.devices <= 65536);
+}
+
+void raiseFileLimit(uint16_t devices)
+{
+	//Three sockets per device (TCP, discovery, datagrams), plus connections in flight
+	struct rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit)!=0) return;
+	rlim_t wanted = (rlim_t) devices * 4 + 64;
+	if (limit.rlim_cur>=wanted) return;
+	limit.rlim_cur = std::min(wanted, limit.rlim_max);
+	setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+Totals collectTotals(std::vector<EmulatedDevice>& devices)
+{
+	Totals totals = { 0, 0, 0, 0 };
+	for (size_t i = 0; i<devices.size(); i++) {
+		HomeyClass* homey = devices[i].homey;
+		totals.requests += homey->stats().other.requests.load(std::memory_order_relaxed);
+		totals.requests += homey->findCapability("state")->stats.requests.load(std::memory_order_relaxed);
+		totals.requests += homey->findAction("setState")->stats.requests.load(std::memory_order_relaxed);
+		totals.requests += homey->findCondition("getState")->stats.requests.load(std::memory_order_relaxed);
+		totals.discoveries += homey->stats().discoveries.load(std::memory_order_relaxed);
+		totals.emits += homey->emitStats().all.emits.load(std::memory_order_relaxed);
+		totals.emitsOk += homey->emitStats().all.results[STATS_EMIT_OK].load(std::memory_order_relaxed);
+	}
+	return totals;
+}
+
+void report(double seconds, const Totals& current, const Totals& previous, Samples& service, Samples& emits)
+{
+	printf("%6.1fs  req %8.1f/s  disc %6.1f/s  emit %8.1f/s (ok %5.1f%%)  "
+		"service p50 %5u p90 %5u p99 %6u max %6u us  emit p50 %5u p99 %6u max %6u us\n",
+		seconds,
+		(current.requests - previous.requests) / seconds,
+		(current.discoveries - previous.discoveries) / seconds,
+		(current.emits - previous.emits) / seconds,
+		(current.emits>previous.emits) ? 100.0 * (current.emitsOk - previous.emitsOk) / (current.emits - previous.emits) : 100.0,
+		service.percentile(0.5), service.percentile(0.9), service.percentile(0.99), service.max(),
+		emits.percentile(0.5), emits.percentile(0.99), emits.max());
+	fflush(stdout);
+	service.values.clear();
+	emits.values.clear();
+}
+
+void watch(int epoll, int fd, uint32_t events, uint32_t source, uint32_t value)
+{
+	struct epoll_event event;
+	event.events = events;
+	event.data.u64 = ((uint64_t) source << 32) | value;
+	epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+}
+
+//True once the request line and headers are in, or the client stopped sending
+bool requestArrived(int fd)
+{
+	char buffer[POSIX_RX_BUFFER];
+	ssize_t n = recv(fd, buffer, sizeof(buffer), MSG_PEEK | MSG_DONTWAIT);
+	if (n<0) return (errno!=EAGAIN) && (errno!=EWOULDBLOCK) && (errno!=EINTR);
+	if ((n==0) || (n==(ssize_t) sizeof(buffer))) return true;
+	for (ssize_t i = 1; i<n; i++) {
+		if ((buffer[i]=='\n') && ((buffer[i-1]=='\n') || ((i>=2) && (buffer[i-1]=='\r') && (buffer[i-2]=='\n')))) return true;
+	}
+	return false;
+}
+
+//Hands a connection to its device, the library answers and closes it
+void serve(int epoll, std::vector<Connection>& connections, int fd, std::vector<EmulatedDevice>& devices, Samples& service)
+{
+	epoll_ctl(epoll, EPOLL_CTL_DEL, fd, NULL);
+	PosixClient client(fd);
+	uint64_t started = nowUs();
+	devices[connections[fd].device].homey->handleClient(client);
+	service.add(nowUs() - started);
+	connections[fd].device = -1;
+}
+
+//Answers every discovery waiting on a UDP socket, for one device or all of them
+void answerDiscoveries(int fd, std::vector<EmulatedDevice>& devices, int device)
+{
+	uint8_t packet[POSIX_UDP_BUFFER];
+	struct sockaddr_in sender;
+	socklen_t length = sizeof(sender);
+	while (recvfrom(fd, packet, sizeof(packet), MSG_DONTWAIT, (struct sockaddr*) &sender, &length)>=0) {
+		IPAddress host((uint32_t) sender.sin_addr.s_addr);
+		uint16_t port = ntohs(sender.sin_port);
+		for (size_t i = 0; i<devices.size(); i++) {
+			if ((device<0) || ((size_t) device==i)) devices[i].homey->answerDiscovery(host, port);
+		}
+		length = sizeof(sender);
+	}
+}
+
+int openBroadcastSocket(const Options& options)
+{
+	int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+	if (fd<0) return -1;
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(options.port);
+	address.sin_addr.s_addr = (uint32_t) options.broadcast;
+	if (bind(fd, (struct sockaddr*) &address, sizeof(address))<0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!parseOptions(argc, argv, options)) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	signal(SIGINT, stopRunning);
+	signal(SIGTERM, stopRunning);
+	signal(SIGPIPE, SIG_IGN);
+	randomSeed(getpid());
+	raiseFileLimit(options.devices);
+
+	int epoll = epoll_create1(0);
+	if (epoll<0) {
+		perror("epoll_create1");
+		return 1;
+	}
+
+	//Create the devices, the epoll data names the socket and its device
+	std::vector<EmulatedDevice> devices(options.devices);
+	uint64_t started = nowUs();
+	for (uint16_t i = 0; i<options.devices; i++) {
+		EmulatedDevice& device = devices[i];
+		device.homey = new HomeyClass(devicePort(options, i));
+		device.state = 0;
+		device.actions = 0;
+		device.nextEmitUs = 0;
+
+		HomeyClass* homey = device.homey;
+		homey->setLocalAddress(deviceAddress(options, i));
+		homey->begin(String("keypad-") + String((unsigned int) i));
+		homey->setClass("remote");
+		homey->addCapability("state");
+		homey->addAction("setState", HomeyDelegate::bind(&device, setState));
+		homey->addCondition("getState", HomeyDelegate::bind(&device, getState));
+		if (options.datagramPort>0) homey->beginDatagram(options.datagramHost, options.datagramPort, 0); //Own port, own acks
+
+		if ((homey->tcpDescriptor()<0) || (homey->udpDescriptor()<0)) {
+			fprintf(stderr, "device %u: could not open %s:%u\n", i,
+				deviceAddress(options, i).toString().c_str(), devicePort(options, i));
+			return 1;
+		}
+		watch(epoll, homey->tcpDescriptor(), EPOLLIN, SOURCE_LISTEN, i);
+		watch(epoll, homey->udpDescriptor(), EPOLLIN, SOURCE_DISCOVERY, i);
+
+		//Spread the first emits over one period so devices don't fire together
+		if (options.emitRate>0) device.nextEmitUs = started + random(1, (long) (1000000 / options.emitRate) + 1);
+	}
+
+	int broadcast = -1;
+	if (sharedPort(options)) {
+		broadcast = openBroadcastSocket(options);
+		if (broadcast<0) {
+			perror("broadcast socket");
+			return 1;
+		}
+		watch(epoll, broadcast, EPOLLIN, SOURCE_BROADCAST, 0);
+		printf("%u devices on %s-%s port %u, %.2f emits/s per device\n", options.devices,
+			deviceAddress(options, 0).toString().c_str(), deviceAddress(options, options.devices - 1).toString().c_str(),
+			options.port, options.emitRate);
+	} else {
+		printf("%u devices on ports %u-%u, %.2f emits/s per device\n",
+			options.devices, options.port, options.port + options.devices - 1, options.emitRate);
+	}
+	fflush(stdout);
+
+	Samples service;
+	Samples emits;
+	std::vector<Connection> connections;
+	uint32_t open = 0;
+	Totals previous = collectTotals(devices);
+	uint64_t lastReport = started;
+	uint64_t lastTick = started;
+	uint64_t emitPeriodUs = (options.emitRate>0) ? (uint64_t) (1000000 / options.emitRate) : 0;
+	struct epoll_event events[EMULATOR_EVENTS];
+
+	while (running) {
+		int count = epoll_wait(epoll, events, EMULATOR_EVENTS, EMULATOR_TICK_MS);
+		if ((count<0) && (errno!=EINTR)) {
+			perror("epoll_wait");
+			break;
+		}
+
+		//Nothing here waits: requests are served once complete, service time is per request
+		for (int i = 0; i<count; i++) {
+			uint32_t source = events[i].data.u64 >> 32;
+			uint32_t value = (uint32_t) events[i].data.u64;
+			if (source==SOURCE_LISTEN) {
+				int fd;
+				while ((fd = accept4(devices[value].homey->tcpDescriptor(), NULL, NULL, SOCK_NONBLOCK))>=0) {
+					if ((size_t) fd>=connections.size()) connections.resize(fd + 1, Connection { -1, 0 });
+					connections[fd].device = value;
+					connections[fd].acceptedUs = nowUs();
+					open++;
+					watch(epoll, fd, EPOLLIN | EPOLLRDHUP, SOURCE_CONNECTION, fd);
+				}
+			} else if (source==SOURCE_CONNECTION) {
+				if (requestArrived(value)) {
+					serve(epoll, connections, value, devices, service);
+					open--;
+				}
+			} else if (source==SOURCE_DISCOVERY) {
+				answerDiscoveries(devices[value].homey->udpDescriptor(), devices, value);
+			} else if (source==SOURCE_BROADCAST) {
+				answerDiscoveries(broadcast, devices, -1);
+			}
+		}
+
+		uint64_t now = nowUs();
+		if (now - lastTick >= EMULATOR_TICK_MS * 1000ULL) {
+			lastTick = now;
+
+			//Requests that did not complete in time get what the device would answer then
+			for (size_t fd = 0; (open>0) && (fd<connections.size()); fd++) {
+				if ((connections[fd].device<0) || (now - connections[fd].acceptedUs < REQUEST_TIMEOUT * 1000ULL)) continue;
+				serve(epoll, connections, fd, devices, service);
+				open--;
+			}
+
+			//Emits and datagram retransmissions
+			for (size_t i = 0; i<devices.size(); i++) {
+				EmulatedDevice& device = devices[i];
+				if (options.datagramPort>0) device.homey->datagram()->loop();
+				if ((device.nextEmitUs==0) || (device.nextEmitUs>now)) continue;
+				device.nextEmitUs += emitPeriodUs;
+				if (device.nextEmitUs<now) device.nextEmitUs = now + emitPeriodUs; //Fell behind, don't burst
+				uint64_t emitStarted = nowUs();
+				device.homey->trigger("stateChanged", device.state);
+				emits.add(nowUs() - emitStarted);
+			}
+		}
+
+		if ((now - lastReport) >= options.interval * 1000000ULL) {
+			Totals current = collectTotals(devices);
+			report((now - lastReport) / 1e6, current, previous, service, emits);
+			previous = current;
+			lastReport = now;
+		}
+		if ((options.duration>0) && (now - started >= options.duration * 1000000ULL)) break;
+	}
+
+	//Totals over the whole run
+	Totals totals = collectTotals(devices);
+	double seconds = (nowUs() - started) / 1e6;
+	uint64_t actions = 0;
+	for (size_t i = 0; i<devices.size(); i++) actions += devices[i].actions;
+	printf("total: %.1fs, %llu requests (%.1f/s), %llu actions, %llu discoveries, %llu emits (%llu ok)\n",
+		seconds, (unsigned long long) totals.requests, totals.requests / seconds, (unsigned long long) actions,
+		(unsigned long long) totals.discoveries, (unsigned long long) totals.emits, (unsigned long long) totals.emitsOk);
+
+	for (size_t fd = 0; fd<connections.size(); fd++) {
+		if (connections[fd].device>=0) close(fd);
+	}
+	for (size_t i = 0; i<devices.size(); i++) {
+		devices[i].homey->stop();
+		delete devices[i].homey;
+	}
+	if (broadcast>=0) close(broadcast);
+	close(epoll);
+	return 0;
+}
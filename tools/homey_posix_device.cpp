@@ -0,0 +1,62 @@
+/*
+ * Homeyduino device running as a Linux process (HOMEY_USE_POSIX).
+ *
+ * Exposes the same Homey endpoints as the keypad firmware on real sockets, so
+ * discovery, actions, conditions and emits can be exercised from a workstation:
+ *
+ *   pio run -e native && .pio/build/native/program "Alarm Keypad" 46639
+ */
+
+#include <Homey.h>
+
+#include <signal.h>
+#include <unistd.h>
+
+HomeyClass* homey = &Homey;
+int state = 0;
+volatile sig_atomic_t running = 1;
+
+void setState(int newState)
+{
+	state = newState;
+	homey->setCapabilityValue("state", state); //Emitted when a master is set
+}
+
+void getState()
+{
+	homey->returnResult(state);
+}
+
+void stopRunning(int)
+{
+	running = 0;
+}
+
+int main(int argc, char** argv)
+{
+	const char* name = (argc>1) ? argv[1] : "Alarm Keypad";
+	uint16_t port = (argc>2) ? atoi(argv[2]) : 46639;
+
+	signal(SIGINT, stopRunning);
+	signal(SIGTERM, stopRunning);
+	randomSeed(getpid());
+
+	HomeyClass other(port);
+	if (port!=46639) homey = &other; //The global instance always listens on the default port
+
+	homey->begin(name);
+	homey->setClass("remote");
+	homey->addCapability("state");
+	homey->addAction("Set Alarm State", HomeyDelegate::of<int>(setState));
+	homey->addCondition("Get Alarm State", getState);
+
+	printf("%s listening on port %u\n", name, port);
+	fflush(stdout);
+
+	while (running) {
+		if (!homey->loop()) usleep(1000); //Nothing happened, don't spin
+	}
+
+	homey->stop();
+	return 0;
+}
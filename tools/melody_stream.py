@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Converts a melody from CSV into the compact note stream of src/MelodyStream.hpp.
+
+The input has one note per line, `frequency,duration` with the frequency in Hz
+(0 is a rest) and the duration in ms. Lines starting with '#' are comments;
+the leading ones are copied into the generated header. Example:
+
+    python3 tools/melody_stream.py tools/melodies/monkey_island.csv \\
+        --name MonkeyIslandTheme --output src/easteregg.hpp
+
+Stream format, one entry per note:
+
+    byte 0   bits 0-5  index into the frequency table
+             bit 6     duration equals the previous note's, nothing follows
+    then     the duration as an unsigned LEB128 varint (7 bits per byte,
+             least significant first, bit 7 set on all but the last byte)
+"""
+
+import argparse
+import sys
+
+MAX_FREQUENCIES = 64
+SAME_DURATION = 0x40
+MAX_DURATION = 0xFFFF
+
+
+def read_melody(path):
+    comments, notes = [], []
+    with open(path) as source:
+        for number, line in enumerate(source, 1):
+            line = line.strip()
+            if not line:
+                continue
+            if line.startswith("#"):
+                if not notes:
+                    comments.append(line[1:].strip())
+                continue
+            try:
+                frequency, duration = (int(field) for field in line.split(","))
+            except ValueError:
+                sys.exit(f"{path}:{number}: expected 'frequency,duration'")
+            if not 0 <= frequency <= 0xFFFF or not 0 <= duration <= MAX_DURATION:
+                sys.exit(f"{path}:{number}: value out of range")
+            notes.append((frequency, duration))
+    return comments, notes
+
+
+def varint(value):
+    encoded = bytearray()
+    while value >= 0x80:
+        encoded.append((value & 0x7F) | 0x80)
+        value >>= 7
+    encoded.append(value)
+    return encoded
+
+
+def encode(notes):
+    # Rests first, so index 0 is always silence
+    frequencies = sorted({frequency for frequency, _ in notes} | {0})
+    if len(frequencies) > MAX_FREQUENCIES:
+        sys.exit(f"{len(frequencies)} different frequencies, the format holds {MAX_FREQUENCIES}")
+    index = {frequency: i for i, frequency in enumerate(frequencies)}
+
+    stream = bytearray()
+    previous = None
+    for frequency, duration in notes:
+        if duration == previous:
+            stream.append(index[frequency] | SAME_DURATION)
+        else:
+            stream.append(index[frequency])
+            stream += varint(duration)
+        previous = duration
+    return frequencies, stream
+
+
+def decode(frequencies, stream):
+    notes, position, previous = [], 0, 0
+    while position < len(stream):
+        head = stream[position]
+        position += 1
+        duration = previous
+        if not head & SAME_DURATION:
+            duration, shift = 0, 0
+            while True:
+                byte = stream[position]
+                position += 1
+                duration |= (byte & 0x7F) << shift
+                shift += 7
+                if not byte & 0x80:
+                    break
+        notes.append((frequencies[head & 0x3F], duration))
+        previous = duration
+    return notes
+
+
+def array_lines(values, per_line, width, indent):
+    for start in range(0, len(values), per_line):
+        chunk = values[start:start + per_line]
+        yield indent + " ".join(f"{value:>{width}}," for value in chunk)
+
+
+def header(name, source, comments, notes, frequencies, stream):
+    lines = ["#pragma once", "", "//"]
+    lines += [f"// {comment}".rstrip() for comment in comments]
+    lines += [
+        "//",
+        f"// Generated by tools/melody_stream.py from {source}, do not edit.",
+        f"// {len(notes)} notes in {len(stream)} bytes, {len(notes) * 4} as plain arrays.",
+        "//",
+        "",
+        '#include "MelodyStream.hpp"',
+        "",
+        f"namespace {name} {{",
+        "",
+        "    constexpr uint16_t FREQUENCIES [] = {",
+        *array_lines(frequencies, 12, 5, "        "),
+        "    };",
+        "",
+        "    constexpr uint8_t NOTES [] = {",
+        *array_lines([f"0x{byte:02X}" for byte in stream], 12, 4, "        "),
+        "    };",
+        "",
+        f"}}  // namespace {name}",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="CSV with frequency,duration per note")
+    parser.add_argument("--name", required=True, help="C++ namespace of the generated arrays")
+    parser.add_argument("--output", help="header to write, stdout when omitted")
+    args = parser.parse_args()
+
+    comments, notes = read_melody(args.input)
+    frequencies, stream = encode(notes)
+    if decode(frequencies, stream) != notes:
+        sys.exit("internal error: the stream does not decode to the input")
+
+    text = header(args.name, args.input, comments, notes, frequencies, stream)
+    if args.output:
+        with open(args.output, "w") as output:
+            output.write(text)
+        print(f"{len(notes)} notes, {len(frequencies)} frequencies, {len(stream)} bytes")
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()